@@ -0,0 +1,77 @@
+#include "mycad/Bvh.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto millisecondsSince(Clock::time_point start) -> double
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+}
+
+// Builds a Bvh over a million short Lines scattered across a sketch, and times
+// the interactive queries against it
+int main()
+{
+    std::size_t const n = 1'000'000;
+    std::size_t const queries = 10'000;
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> position(0, 10'000);
+    std::uniform_real_distribution<float> step(-5, 5);
+
+    mycad::Entity entity;
+    entity.beginBatch();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        float const x = position(rng);
+        float const y = position(rng);
+
+        auto v1 = entity.addVertex({x, y, 0});
+        auto v2 = entity.addVertex({x + step(rng), y + step(rng), 0});
+        entity.addEdge(v1, v2);
+    }
+    entity.commit();
+
+    auto start = Clock::now();
+    mycad::Bvh bvh(entity);
+    double const build = millisecondsSince(start);
+
+    start = Clock::now();
+    bvh.refit(entity);
+    double const refit = millisecondsSince(start);
+
+    std::size_t found = 0;
+    start = Clock::now();
+    for (std::size_t i = 0; i < queries; i++)
+    {
+        found += bvh.nearest({position(rng), position(rng), 0}).has_value();
+    }
+    double const nearest = millisecondsSince(start) / queries;
+
+    start = Clock::now();
+    for (std::size_t i = 0; i < queries; i++)
+    {
+        found += bvh.pick({{position(rng), position(rng), 100}, {0, 0, -1}}, 1).has_value();
+    }
+    double const pick = millisecondsSince(start) / queries;
+
+    start = Clock::now();
+    for (std::size_t i = 0; i < queries; i++)
+    {
+        float const x = position(rng);
+        float const y = position(rng);
+        found += bvh.select({{x, y, -1}, {x + 50, y + 50, 1}}).size();
+    }
+    double const select = millisecondsSince(start) / queries;
+
+    std::cout << "edges: " << bvh.size() << ", found: " << found << "\n"
+              << "build: " << build << " ms, refit: " << refit << " ms\n"
+              << "nearest: " << nearest * 1000 << " us, pick: " << pick * 1000
+              << " us, select (50x50): " << select * 1000 << " us" << std::endl;
+}
@@ -0,0 +1,114 @@
+#include "mycad/Distances.h"
+#include "mycad/PreparedLine.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto nanosecondsSince(Clock::time_point start, std::size_t n) -> double
+    {
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() /
+               static_cast<double>(n);
+    }
+}
+
+// Times each batched distance kernel over a million Points or Lines (or as
+// many as given on the command line), against doing the same one at a time
+int main(int argc, char **argv)
+{
+    std::size_t const n = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    int const rounds = 20;
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> position(-1000, 1000);
+    auto random = [&]() { return mycad::Point{position(rng), position(rng), position(rng)}; };
+
+    std::vector<mycad::Point> points(n), starts(n), ends(n);
+    std::vector<mycad::Line> lines;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        points[i] = random();
+        starts[i] = random();
+        ends[i] = random();
+        lines.push_back(mycad::makeLine(starts[i], ends[i]).value());
+    }
+
+    mycad::PointArray const pointArray(points);
+    mycad::PointArray const startArray(starts);
+    mycad::PointArray const endArray(ends);
+
+    auto const line = mycad::makeLine({-500, 200, 0}, {700, -100, 50}).value();
+    mycad::PreparedLine const prepared(line);
+    mycad::Point const p{10, 20, 30};
+
+    std::vector<float> us(n), vs(n), distances(n);
+    double checksum = 0;
+
+    auto start = Clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+        mycad::closestPoints(line, pointArray, us, distances);
+        checksum += distances[r];
+    }
+    double const pointsBatched = nanosecondsSince(start, n * rounds);
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            distances[i] = prepared.distance(points[i]);
+        }
+        checksum += distances[r];
+    }
+    double const pointsScalar = nanosecondsSince(start, n * rounds);
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+        mycad::closestPoints(startArray, endArray, p, us, distances);
+        checksum += distances[r];
+    }
+    double const linesBatched = nanosecondsSince(start, n * rounds);
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            distances[i] = mycad::PreparedLine(lines[i]).distance(p);
+        }
+        checksum += distances[r];
+    }
+    double const linesScalar = nanosecondsSince(start, n * rounds);
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+        mycad::closestApproaches(line, startArray, endArray, us, vs, distances);
+        checksum += distances[r];
+    }
+    double const approachBatched = nanosecondsSince(start, n * rounds);
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            distances[i] = mycad::closestApproach(lines[i], line).distance;
+        }
+        checksum += distances[r];
+    }
+    double const approachScalar = nanosecondsSince(start, n * rounds);
+
+    std::cout << "n: " << n << " (checksum " << checksum << "), ns per item, batched / one at a time\n"
+              << "points to a Line: " << pointsBatched << " / " << pointsScalar << "\n"
+              << "a Point to Lines: " << linesBatched << " / " << linesScalar << "\n"
+              << "Lines to a Line:  " << approachBatched << " / " << approachScalar
+              << std::endl;
+}
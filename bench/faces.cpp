@@ -0,0 +1,49 @@
+#include "mycad/Entity.h"
+
+#include <chrono>
+#include <iostream>
+
+// Times Entity::findFaces on a square grid sketch of roughly 100k Edges
+int main()
+{
+    std::size_t const n = 224; // 2 * n * (n - 1) ≈ 100k Edges
+
+    mycad::Entity entity;
+    entity.beginBatch();
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        for (std::size_t j = 0; j < n; j++)
+        {
+            entity.addVertex({static_cast<float>(i), static_cast<float>(j), 0});
+        }
+    }
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        for (std::size_t j = 0; j < n; j++)
+        {
+            mycad::VertexID const v = i * n + j;
+            if (i + 1 < n)
+            {
+                entity.addEdge(v, v + n);
+            }
+            if (j + 1 < n)
+            {
+                entity.addEdge(v, v + 1);
+            }
+        }
+    }
+
+    entity.commit();
+
+    auto const start = std::chrono::steady_clock::now();
+    mycad::Faces const faces = entity.findFaces();
+    auto const stop = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double, std::milli> const elapsed = stop - start;
+
+    std::cout << "edges: " << entity.edges().size()
+              << ", faces: " << faces.size()
+              << ", findFaces: " << elapsed.count() << " ms" << std::endl;
+}
@@ -0,0 +1,54 @@
+#include "mycad/Intersections.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto millisecondsSince(Clock::time_point start) -> double
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+}
+
+// Finds the crossings among a million short Lines, first on one thread and
+// then on every hardware thread
+int main()
+{
+    std::size_t const n = 1'000'000;
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> position(0, 10'000);
+    std::uniform_real_distribution<float> step(-15, 15);
+
+    mycad::Entity entity;
+    entity.beginBatch();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        float const x = position(rng);
+        float const y = position(rng);
+
+        auto v1 = entity.addVertex({x, y, 0});
+        auto v2 = entity.addVertex({x + step(rng), y + step(rng), 0});
+        entity.addEdge(v1, v2);
+    }
+    entity.commit();
+
+    auto start = Clock::now();
+    auto const serial = mycad::findIntersections(entity, 1);
+    double const serialTime = millisecondsSince(start);
+
+    start = Clock::now();
+    auto const parallel = mycad::findIntersections(entity, 0);
+    double const parallelTime = millisecondsSince(start);
+
+    std::cout << "edges: " << n << ", intersections: " << serial.size()
+              << (serial == parallel ? "" : " (MISMATCH)") << "\n"
+              << "1 thread: " << serialTime << " ms, "
+              << std::thread::hardware_concurrency() << " threads: " << parallelTime << " ms"
+              << std::endl;
+}
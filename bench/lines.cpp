@@ -0,0 +1,62 @@
+#include "mycad/render_helpers.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto millisecondsSince(Clock::time_point start) -> double
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+}
+
+// Meshes a million short Lines scattered across a sketch, with one in ten of
+// them removed, on one thread and then on every hardware thread
+int main()
+{
+    std::size_t const n = 1'000'000;
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> position(0, 10'000);
+    std::uniform_real_distribution<float> step(-5, 5);
+
+    mycad::Entity entity;
+    entity.beginBatch();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        float const x = position(rng);
+        float const y = position(rng);
+
+        auto v1 = entity.addVertex({x, y, 0});
+        auto v2 = entity.addVertex({x + step(rng), y + step(rng), 0});
+        entity.addEdge(v1, v2);
+    }
+    entity.commit();
+
+    for (std::size_t e = 0; e < n; e += 10)
+    {
+        entity.removeEdge(static_cast<mycad::EdgeID>(e));
+    }
+
+    auto start = Clock::now();
+    auto const serial = makeLineMesh(entity, 1);
+    double const one = millisecondsSince(start);
+
+    start = Clock::now();
+    auto const parallel = makeLineMesh(entity, 0);
+    double const all = millisecondsSince(start);
+
+    std::cout << "edges: " << entity.edges().size()
+              << ", vertices: " << parallel->getVertices().size()
+              << ", same: " << std::boolalpha
+              << (serial->getVertices() == parallel->getVertices() &&
+                  serial->getIndices() == parallel->getIndices()) << "\n"
+              << "1 thread: " << one << " ms, "
+              << std::thread::hardware_concurrency() << " threads: " << all
+              << " ms" << std::endl;
+}
@@ -0,0 +1,99 @@
+#include "mycad/SpatialIndex.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto millisecondsSince(Clock::time_point start) -> double
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+}
+
+// Indexes ten million Points (or as many as given on the command line) with
+// both a PointGrid and a KdTree, and times building and querying each one
+int main(int argc, char **argv)
+{
+    std::size_t const n = argc > 1 ? std::stoul(argv[1]) : 10'000'000;
+    std::size_t const queries = 100'000;
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> position(0, 10'000);
+
+    std::vector<mycad::Point> points(n);
+    for (auto &p : points)
+    {
+        p = {position(rng), position(rng), position(rng) / 100};
+    }
+
+    std::vector<mycad::Point> targets(queries);
+    for (auto &p : targets)
+    {
+        p = {position(rng), position(rng), position(rng) / 100};
+    }
+    std::vector<mycad::MaybeNeighbour> found(queries);
+
+    auto start = Clock::now();
+    mycad::PointGrid grid(10);
+    grid.reserve(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        grid.insert(i, points[i]);
+    }
+    double const gridBuild = millisecondsSince(start);
+
+    start = Clock::now();
+    grid.nearest(targets, found);
+    double const gridNearest = millisecondsSince(start) / queries;
+
+    start = Clock::now();
+    std::size_t gridHits = 0;
+    for (auto const &p : targets)
+    {
+        gridHits += grid.withinRadius(p, 10).size();
+    }
+    double const gridRadius = millisecondsSince(start) / queries;
+
+    start = Clock::now();
+    for (std::size_t i = 0; i < queries; i++)
+    {
+        grid.move(i, targets[i]);
+    }
+    double const gridMove = millisecondsSince(start) / queries;
+
+    start = Clock::now();
+    mycad::KdTree tree(points);
+    double const treeBuild = millisecondsSince(start);
+
+    start = Clock::now();
+    tree.nearest(targets, found);
+    double const treeNearest = millisecondsSince(start) / queries;
+
+    start = Clock::now();
+    std::size_t treeHits = 0;
+    for (auto const &p : targets)
+    {
+        treeHits += tree.withinRadius(p, 10).size();
+    }
+    double const treeRadius = millisecondsSince(start) / queries;
+
+    start = Clock::now();
+    for (std::size_t i = 0; i < queries; i++)
+    {
+        tree.remove(i);
+        tree.insert(i, targets[i]);
+    }
+    double const treeMove = millisecondsSince(start) / queries;
+
+    std::cout << "points: " << n << ", radius hits: " << gridHits << " / " << treeHits << "\n"
+              << "PointGrid: build " << gridBuild << " ms, nearest " << gridNearest * 1000
+              << " us, radius " << gridRadius * 1000 << " us, move " << gridMove * 1000 << " us\n"
+              << "KdTree:    build " << treeBuild << " ms, nearest " << treeNearest * 1000
+              << " us, radius " << treeRadius * 1000 << " us, move " << treeMove * 1000 << " us"
+              << std::endl;
+}
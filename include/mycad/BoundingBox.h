@@ -0,0 +1,56 @@
+#ifndef MYCAD_BOUNDING_BOX_HEADER
+#define MYCAD_BOUNDING_BOX_HEADER
+
+#include "mycad/Geometry.h"
+
+#include <iostream>
+#include <optional>
+
+namespace mycad
+{
+    /** @brief an axis-aligned box, from BoundingBox#min to BoundingBox#max
+     *
+     *  A box may be flat (or even a single point) in any direction, but every
+     *  component of BoundingBox#min is always less than or equal to the same
+     *  component of BoundingBox#max.
+     */
+    struct BoundingBox
+    {
+        Point min, max;
+
+        auto operator<=>(BoundingBox const&) const = default;
+
+        /** @brief grows the box just enough to include @param p
+         */
+        auto expand(Point const &p) -> void;
+
+        /** @brief grows the box just enough to include @param other
+         */
+        auto expand(BoundingBox const &other) -> void;
+
+        /** @returns true if @param p is inside or on the surface of the box
+         */
+        auto contains(Point const &p) const -> bool;
+
+        /** @returns true if the two boxes overlap, including if they only
+         *           touch
+         */
+        auto intersects(BoundingBox const &other) const -> bool;
+
+        auto center() const -> Point;
+    };
+
+    using MaybeBoundingBox = std::optional<BoundingBox>;
+
+    /** @returns the smallest box containing both points
+     */
+    auto makeBoundingBox(Point const &p1, Point const &p2) -> BoundingBox;
+
+    /** @returns the smallest box containing the whole Line
+     */
+    auto makeBoundingBox(Line const &line) -> BoundingBox;
+
+    auto operator<<(std::ostream &stream, BoundingBox const &box) -> std::ostream &;
+} // namespace mycad
+
+#endif // MYCAD_BOUNDING_BOX_HEADER
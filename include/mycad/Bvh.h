@@ -0,0 +1,128 @@
+#ifndef MYCAD_BVH_HEADER
+#define MYCAD_BVH_HEADER
+
+#include "mycad/BoundingBox.h"
+#include "mycad/Entity.h"
+#include "mycad/Geometry.h"
+#include "mycad/PreparedLine.h"
+#include "mycad/Types.h"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace mycad
+{
+    /** @brief a half-line, starting at Ray#origin and heading off along
+     *         Ray#direction
+     */
+    struct Ray
+    {
+        Point origin;
+        Point direction;
+    };
+
+    /** @brief the answer to a Bvh query
+     */
+    struct EdgeHit
+    {
+        EdgeID edge;
+
+        // The closest Point on the Edge's Line
+        Point point;
+
+        // How far EdgeHit#point is from the query Point, or from the Ray
+        float distance;
+
+        // How far along the Ray EdgeHit#point is (zero for Point queries)
+        float along;
+    };
+
+    using MaybeEdgeHit = std::optional<EdgeHit>;
+
+    /** @brief how Bvh::select decides which Edges are in a box
+     */
+    enum class SelectMode
+    {
+        // The whole Line has to be inside the box
+        Window,
+
+        // Any part of the Line may be inside the box
+        Crossing
+    };
+
+    /** @brief a bounding-volume hierarchy over the Lines of an Entity
+     *
+     *  The tree is built with a binned surface-area heuristic and stored as a
+     *  flat array of nodes, with the two children of each node next to each
+     *  other. Each leaf owns a short run of a second array holding the Lines
+     *  themselves, so queries never go back to the Entity.
+     *
+     *  The Bvh is a snapshot: it doesn't see Edges that are added to the
+     *  Entity after it was built. If only the Points have moved, refit() is
+     *  much cheaper than building a new one.
+     */
+    class Bvh
+    {
+        public:
+            Bvh() = default;
+            explicit Bvh(Entity const &entity);
+
+            /** @brief the number of Edges in the tree
+             */
+            auto size() const -> std::size_t;
+            auto empty() const -> bool;
+
+            /** @brief re-reads every Line from @param entity, and re-computes
+             *         the boxes without changing the shape of the tree
+             *
+             *  This is O(n), but queries slow down if the Points have moved a
+             *  long way, so build a new Bvh after large edits.
+             *
+             *  @returns false, leaving the Bvh as it was, if any of the Edges
+             *           are no longer in @param entity
+             */
+            auto refit(Entity const &entity) -> bool;
+
+            /** @returns the Edge closest to @param p, if there is one no further
+             *           away than @param maxDistance
+             */
+            auto nearest(Point const &p,
+                         float maxDistance = std::numeric_limits<float>::infinity())
+                const -> MaybeEdgeHit;
+
+            /** @returns the first Edge along @param ray that comes within
+             *           @param tolerance of it, e.g. for picking with the mouse
+             */
+            auto pick(Ray const &ray, float tolerance) const -> MaybeEdgeHit;
+
+            /** @returns the Edges in @param box, in no particular order
+             */
+            auto select(BoundingBox const &box,
+                        SelectMode mode = SelectMode::Crossing) const -> EdgeIDs;
+        private:
+            struct Node
+            {
+                BoundingBox box;
+
+                // For a leaf, the first of `count` Items. Otherwise the left
+                // child, with the right child just after it.
+                std::uint32_t first;
+                std::uint32_t count;
+            };
+
+            struct Item
+            {
+                PreparedLine line;
+                EdgeID edge;
+            };
+
+            auto build() -> void;
+
+            std::vector<Node> nodes{};
+            std::vector<Item> items{};
+    };
+} // namespace mycad
+
+#endif // MYCAD_BVH_HEADER
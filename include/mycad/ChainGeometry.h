@@ -0,0 +1,124 @@
+#ifndef MYCAD_CHAIN_GEOMETRY_HEADER
+#define MYCAD_CHAIN_GEOMETRY_HEADER
+
+#include "mycad/Geometry.h"
+#include "mycad/Types.h"
+
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace mycad
+{
+    class Entity;
+
+    /** @brief a place on a Chain, as a point on one of its Edges
+     */
+    struct ChainPosition
+    {
+        EdgeID edge;
+
+        // A parameter along the Edge's own Line (see Line::atU), which runs
+        // from 1 to 0 if the Chain walks the Edge backwards
+        float u;
+    };
+
+    /** @brief the Lines of a Chain, in walking order, parametrized by the
+     *         distance along them
+     *
+     *  The running total of the Lines' lengths is worked out once, so finding
+     *  the point a given distance along the Chain is a binary search and a
+     *  single Line::atU rather than a walk along the whole Chain.
+     *
+     *  This is a snapshot, made by Entity::getChainGeometry, so it doesn't
+     *  follow later changes to the Entity.
+     */
+    class ChainGeometry
+    {
+        public:
+            friend class Entity;
+
+            /** @returns the number of Edges in the Chain
+             */
+            auto size() const -> std::size_t;
+
+            /** @returns the Edges in walking order, the same as
+             *           Topology::getChainEdges
+             */
+            auto edges() const -> EdgeIDs const &;
+
+            /** @returns the Point at each Vertex, in walking order, so there
+             *           is one more than there are Edges
+             */
+            auto points() const -> std::vector<Point>;
+
+            /** @returns the total length of the Chain
+             */
+            auto length() const -> float;
+
+            /** @returns the distance along the Chain to the start of the
+             *           @param i th Edge, or to the end of the Chain if
+             *           @param i is size()
+             */
+            auto lengthBefore(std::size_t i) const -> float;
+
+            /** @brief finds the Edge that is @param s along the Chain
+             *
+             *  Distances before the start or after the end of the Chain are
+             *  clamped to it. A distance that falls exactly on a Vertex is
+             *  placed at the start of the later Edge.
+             */
+            auto locate(float s) const -> ChainPosition;
+
+            /** @returns the point @param s along the Chain (clamped in the
+             *           same way as locate)
+             */
+            auto atLength(float s) const -> Point;
+
+            /** @brief evaluates atLength for every distance in @param ss
+             *
+             *  The results are written to the start of @param out. Rather than
+             *  searching for each distance, a single sweep moves forwards along
+             *  the Chain, so this is fastest if @param ss is sorted. Any
+             *  distance that goes backwards starts a new search.
+             *
+             *  @returns false, without writing anything, if @param out is
+             *           smaller than @param ss
+             */
+            auto atLengths(std::span<float const> ss, std::span<Point> out) const -> bool;
+        private:
+            struct Piece
+            {
+                EdgeID edge;
+                Line line;
+
+                // Whether the Chain walks from the end of the Line to its start
+                bool reversed;
+            };
+
+            ChainGeometry() = default;
+
+            /** @returns the index of the Piece that @param s falls in
+             */
+            auto find(double s) const -> std::size_t;
+
+            /** @returns the parameter along the walking direction of the
+             *           @param i th Piece, from 0 to 1
+             */
+            auto fraction(std::size_t i, double s) const -> float;
+
+            auto at(std::size_t i, double s) const -> Point;
+
+            std::vector<Piece> pieces{};
+            EdgeIDs ids{};
+
+            // prefix[i] is the total length of the first `i` Pieces, so there
+            // is one more than there are Pieces. Summed in double, so that it
+            // stays accurate over thousands of Edges.
+            std::vector<double> prefix{};
+    };
+
+    using MaybeChainGeometry = std::optional<ChainGeometry>;
+} // namespace mycad
+
+#endif // MYCAD_CHAIN_GEOMETRY_HEADER
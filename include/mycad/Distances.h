@@ -0,0 +1,69 @@
+#ifndef MYCAD_DISTANCES_HEADER
+#define MYCAD_DISTANCES_HEADER
+
+#include "mycad/Geometry.h"
+#include "mycad/PointArray.h"
+
+#include <span>
+
+namespace mycad
+{
+    /** @brief where two Lines come closest to each other
+     */
+    struct Approach
+    {
+        // The closest point on each Line, as a parameter along it (see
+        // Line::atU), between 0 and 1
+        float u1, u2;
+
+        float distance;
+    };
+
+    /** @returns where the part of @param a between its ends comes closest to
+     *           the part of @param b between its ends
+     *
+     *  If the Lines are parallel and overlap, there are many closest pairs
+     *  of points. The one chosen has Approach#u1 as small as possible.
+     */
+    auto closestApproach(Line const &a, Line const &b) -> Approach;
+
+    /** @brief finds the closest point on @param line to each of @param points
+     *
+     *  The closest point to `points.at(i)` is `line.atU(us[i])`, and is
+     *  `distances[i]` away from it. Every u is between 0 and 1.
+     *
+     *  @returns false, without writing anything, if @param us or
+     *           @param distances is smaller than @param points
+     */
+    auto closestPoints(Line const &line, PointArray const &points,
+                       std::span<float> us, std::span<float> distances) -> bool;
+
+    /** @brief finds the closest point to @param p on each of the Lines from
+     *         `starts.at(i)` to `ends.at(i)`
+     *
+     *  The parameters in @param us are along each of those Lines, and
+     *  @param distances are from @param p.
+     *
+     *  @returns false, without writing anything, if @param starts and
+     *           @param ends are different sizes, or if either output is
+     *           smaller than them
+     */
+    auto closestPoints(PointArray const &starts, PointArray const &ends, Point const &p,
+                       std::span<float> us, std::span<float> distances) -> bool;
+
+    /** @brief closestApproach between @param line and each of the Lines from
+     *         `starts.at(i)` to `ends.at(i)`
+     *
+     *  The parameters in @param us are along each of those Lines, and the
+     *  ones in @param vs are along @param line.
+     *
+     *  @returns false, without writing anything, if @param starts and
+     *           @param ends are different sizes, or if any output is smaller
+     *           than them
+     */
+    auto closestApproaches(Line const &line, PointArray const &starts, PointArray const &ends,
+                           std::span<float> us, std::span<float> vs,
+                           std::span<float> distances) -> bool;
+} // namespace mycad
+
+#endif // MYCAD_DISTANCES_HEADER
@@ -0,0 +1,127 @@
+#ifndef MYCAD_EDGE_VIEW_HEADER
+#define MYCAD_EDGE_VIEW_HEADER
+
+#include "mycad/Geometry.h"
+#include "mycad/Types.h"
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <vector>
+
+namespace mycad
+{
+    /** @brief an Edge and its Line, as visited by an EdgeView
+     */
+    struct EdgeEntry
+    {
+        EdgeID id;
+        Line const &line;
+    };
+
+    /** @brief a non-owning view of the Edges of an Entity, in EdgeID order
+     *
+     *  Nothing is copied: each step reads the Entity's own storage and skips
+     *  Edges that have been deleted. The view is invalidated by any edit that
+     *  adds or removes an Edge.
+     *
+     *  @code
+     *  for (auto const [id, line] : entity.edges()) { ... }
+     *  @endcode
+     */
+    class EdgeView : public std::ranges::view_interface<EdgeView>
+    {
+        public:
+            class Iterator
+            {
+                public:
+                    using value_type        = EdgeEntry;
+                    using difference_type   = std::ptrdiff_t;
+                    using iterator_concept  = std::forward_iterator_tag;
+
+                    Iterator() = default;
+
+                    auto operator*() const -> EdgeEntry
+                    {
+                        return {static_cast<EdgeID>(i), lines[i]};
+                    }
+
+                    auto operator++() -> Iterator &
+                    {
+                        i++;
+                        skipDead();
+                        return *this;
+                    }
+
+                    auto operator++(int) -> Iterator
+                    {
+                        Iterator before = *this;
+                        ++*this;
+                        return before;
+                    }
+
+                    auto operator==(Iterator const &other) const -> bool
+                    {
+                        return i == other.i;
+                    }
+                private:
+                    friend class EdgeView;
+
+                    Iterator(std::span<Line const> lines, std::vector<bool> const *live,
+                             std::size_t i)
+                        : lines(lines), live(live), i(i)
+                    {
+                        skipDead();
+                    }
+
+                    auto skipDead() -> void
+                    {
+                        while (i < lines.size() && not (*live)[i])
+                        {
+                            i++;
+                        }
+                    }
+
+                    std::span<Line const> lines{};
+                    std::vector<bool> const *live = nullptr;
+                    std::size_t i = 0;
+            };
+
+            EdgeView() = default;
+
+            /** @param lines  every Line, indexed by EdgeID
+             *  @param live   whether each Edge still exists
+             *  @param count  the number of Edges that still exist
+             */
+            EdgeView(std::span<Line const> lines, std::vector<bool> const &live,
+                     std::size_t count)
+                : lines(lines), live(&live), count(count){}
+
+            auto begin() const -> Iterator
+            {
+                return {lines, live, 0};
+            }
+
+            auto end() const -> Iterator
+            {
+                return {lines, live, lines.size()};
+            }
+
+            /** @returns the number of Edges visited, in O(1)
+             */
+            auto size() const -> std::size_t
+            {
+                return count;
+            }
+        private:
+            std::span<Line const> lines{};
+            std::vector<bool> const *live = nullptr;
+            std::size_t count = 0;
+    };
+
+    static_assert(std::ranges::forward_range<EdgeView>);
+    static_assert(std::ranges::view<EdgeView>);
+} // namespace mycad
+
+#endif // MYCAD_EDGE_VIEW_HEADER
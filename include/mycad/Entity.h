@@ -1,27 +1,399 @@
 #ifndef MYCAD_ENTITY_HEADER
 #define MYCAD_ENTITY_HEADER
 
+#include "BoundingBox.h"
+#include "ChainGeometry.h"
+#include "EdgeView.h"
 #include "Geometry.h"
+#include "PointArray.h"
 #include "Topology.h"
+#include "Traversal.h"
+#include "detail/ChangeLog.h"
 
 #include <map>
 
 namespace mycad
 {
+    /** @brief a closed loop of Edges found by Entity::findFaces
+     */
+    struct Face
+    {
+        // In walking order, the same as Topology::getChainEdges
+        EdgeIDs edges;
+
+        // Positive for a bounded Face (walked counter-clockwise), negative for
+        // the outer boundary of a connected set of Edges (walked clockwise)
+        float area;
+    };
+
+    using Faces = std::vector<Face>;
+
+    /** @brief everything that has changed since a given Generation, see
+     *         Entity::changesSince
+     */
+    struct EntityChanges
+    {
+        // The Generation the Entity is at now, to ask about next time
+        Generation generation;
+
+        // Vertices that have been added, moved or removed, and Edges that
+        // have been added, removed or whose Line has changed, in the order
+        // they last changed. Removed IDs are listed too, so check each one
+        // with Entity::hasVertex or Entity::hasEdge before reading it.
+        std::vector<VertexID> vertices;
+        EdgeIDs edges;
+
+        // Every VertexID and EdgeID is below these. If they've gone down, a
+        // rollback has removed the IDs from there on, or compact() has
+        // renumbered everything.
+        std::size_t vertexCount;
+        std::size_t edgeCount;
+    };
+
+    /** @brief what Entity::weld merged
+     */
+    struct WeldResult
+    {
+        // Indexed by VertexID: the Vertex that each one was merged into,
+        // which is itself if it was kept
+        std::vector<VertexID> vertices;
+
+        // Each Edge that had a merged end, and the Edge that replaced it. That
+        // is std::nullopt if the Edge was dropped, because both of its ends
+        // were merged together or it would have been the same as another Edge.
+        std::vector<std::pair<EdgeID, MaybeEdgeID>> edges;
+    };
+
+    /** @brief a new position for a Vertex, see Entity::moveVertices
+     */
+    struct VertexMove
+    {
+        VertexID vertex;
+        Point point;
+    };
+
     class Entity
     {
         public:
             auto addVertex(Point const p) -> VertexID;
             auto addEdge(VertexID const v1, VertexID const v2) -> MaybeEdgeID;
 
+            /** @returns true if @param v exists and hasn't been removed
+             */
+            auto hasVertex(VertexID v) const -> bool;
+
+            /** @returns true if @param e exists, in O(1) (unlike
+             *           Topology::hasEdge)
+             */
+            auto hasEdge(EdgeID e) const -> bool;
+
             auto getPoint(VertexID const v) const -> Point;
             auto getLine(EdgeID const e) const -> MaybeLine;
 
+            /** @returns a copy of every Line, in EdgeID order
+             *
+             *  Prefer edges() to read them in place.
+             */
             auto getEdges() const -> Lines;
+
+            /** @returns every Edge and its Line, in EdgeID order, without
+             *           copying anything
+             */
+            auto edges() const -> EdgeView;
+
+            /** @returns the stored Lines, indexed by EdgeID
+             *
+             *  This includes the Lines of deleted Edges, which should be
+             *  skipped by checking hasEdge, which is O(1) (or by using
+             *  edges() instead).
+             */
+            auto getLines() const -> std::span<Line const>;
+
+            auto getTopology() const -> Topology const &;
+
+            /** @brief moves @param v to @param p, along with the ends of the
+             *         Lines that meet there
+             *
+             *  Only the Edges adjacent to @param v are touched, which are
+             *  found through the Topology, so this costs O(degree).
+             *
+             *  @returns false, without changing anything, if the Vertex
+             *           doesn't exist or the move would shrink one of its
+             *           Lines to a single point
+             */
+            auto moveVertex(VertexID v, Point const p) -> bool;
+
+            /** @brief makes every move in @param moves, as if by moveVertex
+             *
+             *  The moves are all made or, if any of them fails, none are. A
+             *  Vertex that appears more than once ends up at its last Point.
+             */
+            auto moveVertices(std::span<VertexMove const> moves) -> bool;
+
+            /** @brief merges Vertices that are within @param tolerance of
+             *         each other, e.g. to connect up imported line soup
+             *
+             *  Edges are re-made between the Vertices that are kept, so they
+             *  get new EdgeIDs, and any that would collapse to a point or
+             *  duplicate another Edge are dropped. The Vertices that were
+             *  merged away are left behind as free Vertices, with their
+             *  VertexIDs still valid, for the caller to remove if it wants.
+             *  Chains that lose an Edge are broken.
+             *
+             *  A tolerance of zero merges only Vertices at exactly the same
+             *  Point. This runs in close to O(n) using a PointGrid. The old
+             *  Edges' slots are left behind, for compact() to reclaim.
+             */
+            auto weld(float tolerance) -> WeldResult;
+
+            /** @brief removes @param e from the Topology and the Entity
+             *
+             *  Its Line is left in place but marked as dead (it is skipped by
+             *  edges() and getEdges()), so this is O(1) apart from updating
+             *  the Topology. EdgeIDs are never reused, except by compact().
+             *  Any Chain through the Edge is broken.
+             *
+             *  @returns false if the Edge doesn't exist
+             */
+            auto removeEdge(EdgeID e) -> bool;
+
+            /** @brief removes @param v and every Edge adjacent to it, in
+             *         O(degree)
+             *
+             *  As with Edges, the Vertex's slot is marked as dead rather than
+             *  reused, so getPoint() no longer accepts it.
+             *
+             *  @returns false if the Vertex doesn't exist
+             */
+            auto removeVertex(VertexID v) -> bool;
+
+            /** @brief renumbers the Vertices and Edges to close the gaps left
+             *         by removed ones, see Topology::compact
+             *
+             *  Removed Vertices and Edges keep their slots until this is
+             *  called, so whole-Entity work such as edges(), bounds() and
+             *  findFaces() costs O(every ID ever handed out). Call this after
+             *  a lot of removing (e.g. once edges().size() is less than half
+             *  of getLines().size()) to bring that back down to O(what's
+             *  left). It costs O(V + E log E).
+             *
+             *  Every remaining Vertex and Edge is reported by changesSince as
+             *  having changed, in a new Generation.
+             *
+             *  @returns the mapping from old IDs to new ones, or std::nullopt
+             *           (and nothing changes) if a batch is open
+             */
+            auto compact() -> std::optional<IDRemap>;
+
+            /** @returns the current Generation, which goes up by one with
+             *           every edit to the Points or Lines
+             */
+            auto generation() const -> Generation;
+
+            /** @brief finds what has changed after @param since, so that e.g.
+             *         a mesh only needs remaking for those Edges
+             *
+             *  Each Vertex and Edge is listed once however many times it has
+             *  changed. This costs O(k) for k changes (plus the occasional
+             *  compaction), not O(size of the Entity). Pass 0 for everything.
+             */
+            auto changesSince(Generation since) const -> EntityChanges;
+
+            /** @returns the smallest box containing every Vertex, or
+             *           std::nullopt if there aren't any
+             *
+             *  This is kept up to date as Vertices are added and moved, so it
+             *  costs O(1) unless a Vertex on its surface has been moved
+             *  inwards, when it is worked out again on the next call.
+             *
+             *  Working it out again updates the cached box, so although this
+             *  is const it is not safe to call from several threads at once.
+             */
+            auto bounds() const -> MaybeBoundingBox;
+
+            /** @returns the smallest box containing the Line of @param e, or
+             *           std::nullopt if the Edge doesn't exist
+             */
+            auto getEdgeBounds(EdgeID e) const -> MaybeBoundingBox;
+
+            /** @returns the smallest box containing every Line of @param c,
+             *           or std::nullopt if the Chain doesn't exist
+             *
+             *  This is kept up to date as the Chain is joined and extended, so
+             *  it costs O(log C) for C Chains rather than a walk of the Chain.
+             *  Moving one of its Vertices means walking it once more, on the
+             *  next call. As with bounds(), that walk updates the cached box,
+             *  so this is not safe to call from several threads at once.
+             */
+            auto getChainBounds(Chain c) const -> MaybeBoundingBox;
+
+            /** @brief see Topology::joinEdges
+             */
+            auto joinEdges(EdgeID fromEdge, EdgeID toEdge) -> MaybeChain;
+
+            /** @brief see Topology::extendChain
+             */
+            auto extendChain(Chain c, EdgeID nextEdge) -> bool;
+
+            /** @brief the Lines of @param c, set up for evaluating by the
+             *         distance along them
+             *
+             *  This walks the Chain once, in O(n). Hold on to the result to
+             *  answer many queries about the same Chain.
+             *
+             *  @returns std::nullopt if the Chain doesn't exist
+             */
+            auto getChainGeometry(Chain c) const -> MaybeChainGeometry;
+
+            /** @brief the geometrically shortest path between two Vertices
+             *
+             *  Each Edge costs the length of its Line, otherwise this is the
+             *  same as mycad::shortestPath
+             */
+            auto shortestPath(VertexID from, VertexID to,
+                              TraversalScratch &scratch) const -> MaybeEdgeIDs;
+
+            /** @brief finds the Faces formed by the Edges in the XY plane
+             *
+             *  Every Edge is walked once in each direction, so each Edge ends
+             *  up in exactly two Faces (or twice in the same one if it's a
+             *  dangling Edge or a bridge). Loop Edges are ignored. The z
+             *  coordinates are ignored too, so this is only meaningful for a
+             *  planar sketch without crossing Edges.
+             *
+             *  This runs in O(E log E).
+             */
+            auto findFaces() const -> Faces;
+
+            /** @brief starts a batch of edits, see Topology::beginBatch
+             *  @returns false if a batch is already open
+             */
+            auto beginBatch() -> bool;
+
+            /** @brief keeps every edit made since beginBatch()
+             *  @returns false if no batch is open
+             */
+            auto commit() -> bool;
+
+            /** @brief removes every Vertex and Edge added, and undoes every
+             *         move made, since beginBatch()
+             *  @returns false if no batch is open
+             */
+            auto rollback() -> bool;
         private:
-            std::map<VertexID, Point> vertices = {};
-            std::map<EdgeID, Line> edges = {};
+            /** @returns the box of every Vertex that hasn't been removed
+             */
+            auto liveBounds() const -> MaybeBoundingBox;
+
+            /** @brief works out the bounds of every Vertex and Chain again,
+             *         for after an edit that may have shrunk them
+             */
+            auto recomputeBounds() -> void;
+
+            using ChainKey = std::pair<VertexID, std::size_t>;
+
+            /** @returns the box of @param c found by walking it
+             */
+            auto walkChainBounds(Chain c) const -> MaybeBoundingBox;
+
+            /** @brief walks every Chain that has a box again, e.g. after a
+             *         rollback
+             */
+            auto reindexChains() -> void;
+
+            /** @brief remembers that @param e is part of the Chain @param key
+             */
+            auto indexChain(ChainKey key, EdgeID e) -> void;
+
+            /** @brief walks @param c and keeps a box for it, unless it
+             *         already has one
+             */
+            auto trackChain(Chain c) -> void;
+
+            /** @brief takes in whatever the Chains through @param e now carry
+             *         on to, once @param e has been joined to another Edge
+             */
+            auto growChains(EdgeID e) -> void;
+
+            /** @brief moves the Chain boxes kept at @param v to match its
+             *         Links once @param e is deleted, before it is
+             */
+            auto rekeyChains(VertexID v, EdgeID e) -> void;
+
+            /** @returns true if @param e is known to be part of the Chain
+             *           @param key
+             */
+            auto isIndexed(ChainKey key, EdgeID e) const -> bool;
+
+            /** @brief forgets the Edges of the Chain @param key, before its
+             *         box is dropped
+             */
+            auto unindexChain(ChainKey key) -> void;
+
+            /** @brief leaves the box of @param key, if it has one, to be
+             *         walked again
+             */
+            auto resetChainBox(ChainKey key) -> void;
+
+            /** @brief deletes @param e from the Topology and marks its Line
+             *         as dead, in a new Generation
+             */
+            auto dropEdge(EdgeID e) -> void;
+
+            /** @returns a Line between the current Points of the ends of
+             *           @param e, if they're not in the same place
+             */
+            auto lineBetweenEnds(EdgeID e) const -> MaybeLine;
+
+            /** @brief stores @param line as the Line of @param e, in the
+             *         current Generation
+             */
+            auto replaceLine(EdgeID e, Line const &line) -> void;
+
+            /** @returns the Line of @param e, which must exist
+             */
+            auto lineOf(EdgeID e) const -> Line const &;
+
+            // IDs are handed out by the Topology in increasing order with no
+            // gaps, so they index straight into these
+            PointArray points = {};
+            std::vector<Line> lines = {};
+
+            // 1 for a live Vertex and 0 for a removed one, whose Point stays
+            // put. These are floats so that they can mask the SIMD bounds.
+            std::vector<float> vertexLive = {};
+            std::size_t deadVertices = 0;
+
+            // false for an Edge that has been deleted, whose Line stays put
+            // so that later EdgeIDs still line up
+            std::vector<bool> live = {};
+            std::size_t liveCount = 0;
+
             Topology topo = Topology();
+
+            // worked out again by bounds() if a move may have shrunk it
+            mutable MaybeBoundingBox box = {};
+            mutable bool boxStale = false;
+
+            // keyed by (Chain::whichVertex, Chain::whichLink), which don't
+            // change as the Chain is extended but move down when an earlier
+            // Link at that Vertex is removed (see rekeyChains). A box is
+            // std::nullopt while it needs walking again, which
+            // getChainBounds does lazily.
+            mutable std::map<ChainKey, MaybeBoundingBox> chainBoxes = {};
+            std::multimap<EdgeID, ChainKey> chainsByEdge = {};
+
+            Generation current = 0;
+            detail::ChangeLog vertexChanges = {};
+            detail::ChangeLog edgeChanges = {};
+
+            // the first VertexID and EdgeID that belong to the open batch,
+            // the Points that Vertices were moved from, and the Edges and
+            // Vertices removed since it began
+            std::optional<std::pair<VertexID, EdgeID>> batchStart = {};
+            std::vector<VertexMove> batchMoves = {};
+            EdgeIDs batchDeleted = {};
+            std::vector<VertexID> batchRemoved = {};
     };
 } // namespace mycad
 
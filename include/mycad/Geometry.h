@@ -3,17 +3,27 @@
 
 #include <iostream>
 #include <optional>
+#include <span>
+#include <type_traits>
 #include <utility>
 
 #include "mycad/Types.h"
+#include "mycad/detail/Lerp.h"
 
 namespace mycad
 {
-    struct Point
+    /** @brief a point in 3d space, with coordinates of type @param T
+     *
+     *  mycad::Point (float) is what the rest of the library uses. Only float
+     *  and double are instantiated in the library; double is there for models
+     *  whose coordinates are too large for float to resolve.
+     */
+    template <typename T>
+    struct BasicPoint
     {
-        float x, y, z;
+        T x, y, z;
 
-        auto operator<=>(Point const&) const = default;
+        auto operator<=>(BasicPoint const&) const = default;
     };
 
     /** @brief Parametrized _from_ @param p1 _to_ @param p2
@@ -30,32 +40,210 @@ namespace mycad
      *  @f$ x = p1.x, y = p1.y, z = y1.z @f$, and similarly for
      *  @f$ u=1 @f$ and @param p2.
      *
+     *  The scalar type is never deduced, so braced lists of coordinates can
+     *  be passed directly. It defaults to float; use e.g. `makeLine<double>`
+     *  for a BasicLine<double>.
+     *
      *  @returns A Line if the two points are not equivalent
      */
-    auto makeLine(Point const &p1, Point const &p2) -> MaybeLine;
+    template <typename T = float>
+    constexpr auto makeLine(BasicPoint<std::type_identity_t<T>> const &p1,
+                            BasicPoint<std::type_identity_t<T>> const &p2)
+        -> std::optional<BasicLine<T>>;
 
-    class Line {
+    template <typename T>
+    class BasicLine {
         public:
-            friend auto  makeLine(Point const &p1, Point const &p2) -> MaybeLine;
+            using Point = BasicPoint<T>;
+
+            template <typename U>
+            friend constexpr auto makeLine(BasicPoint<std::type_identity_t<U>> const &p1,
+                                 BasicPoint<std::type_identity_t<U>> const &p2)
+                -> std::optional<BasicLine<U>>;
 
             /** @brief return the point at the given @param u
              *
              *  @returns Line#p1 when `u = 0`, Line#p2 when `u = 1`, the
              *           appropriate extrapolated point on the line otherwise
              */
-            auto atU(float u) const -> Point;
+            constexpr auto atU(T u) const -> Point;
+
+            /** @brief evaluates atU for every u in @param us at once
+             *
+             *  The results are written to the start of @param out. They match
+             *  atU exactly at `u = 0` and `u = 1`, and use the same formula as
+             *  std::lerp everywhere else (so they only differ from atU by
+             *  rounding, e.g. if the compiler fuses a multiply-add). Only
+             *  BasicLine<float> is vectorized.
+             *
+             *  @returns false, without writing anything, if @param out is
+             *           smaller than @param us
+             */
+            auto sampleU(std::span<T const> us, std::span<Point> out) const -> bool;
+
+            /** @brief fills @param out with evenly spaced points, from Line#p1
+             *         at the front to Line#p2 at the back
+             */
+            auto sampleUniform(std::span<Point> out) const -> void;
 
+            /** @returns true if @param p is on the (infinite) line through
+             *           Line#p1 and Line#p2
+             *
+             *  This is true if the three are exactly collinear (see
+             *  mycad::collinear) or if @param p is what atU returns for some
+             *  u. Use mycad::onSegment to allow for a tolerance.
+             *
+             *  The exact collinearity test is only available for float, so a
+             *  BasicLine<double> checks that the cross product is zero
+             *  instead, which can be fooled by rounding.
+             */
             auto intersects(Point const &p) const -> bool;
 
-            bool operator<=>(Line const&) const = default;
+            /** @returns the distance from Line#p1 to Line#p2
+             */
+            auto length() const -> T;
+
+            bool operator<=>(BasicLine const&) const = default;
         private:
-            Line(Point const &p1, Point const &p2);
+            constexpr BasicLine(Point const &p1, Point const &p2);
 
             Point p1, p2;
     };
 
-    auto operator<<(std::ostream &stream, Point const &p) -> std::ostream &;
-    auto operator<<(std::ostream &stream, Line const &line)-> std::ostream &;
+    template <typename T>
+    constexpr auto makeLine(BasicPoint<std::type_identity_t<T>> const &p1,
+                            BasicPoint<std::type_identity_t<T>> const &p2)
+        -> std::optional<BasicLine<T>>
+    {
+        if (p1 == p2)
+        {
+            return std::nullopt;
+        }
+
+        return {BasicLine<T>(p1, p2)};
+    }
+
+    template <typename T>
+    constexpr BasicLine<T>::BasicLine(Point const &p1, Point const &p2)
+        : p1(p1), p2(p2){}
+
+    template <typename T>
+    constexpr auto BasicLine<T>::atU(T u) const -> Point
+    {
+        if (u == 0)
+        {
+            return p1;
+        }
+        else if (u == 1)
+        {
+            return p2;
+        }
+
+        return Point(detail::lerp(p1.x, p2.x, u),
+                     detail::lerp(p1.y, p2.y, u),
+                     detail::lerp(p1.z, p2.z, u)
+                );
+    }
+
+    /** @brief part of a circle, centred on @param center and lying in the
+     *         plane through it that is parallel to XY
+     *
+     *  The Arc starts at @param startAngle (in radians, counter-clockwise from
+     *  the x axis) and turns through @param sweep, which is negative for a
+     *  clockwise Arc.
+     *
+     *  @returns an Arc if @param radius is positive and @param sweep is not
+     *           zero and no more than a full turn either way
+     */
+    auto makeArc(Point const &center, float radius, float startAngle, float sweep) -> MaybeArc;
+
+    class Arc {
+        public:
+            friend auto makeArc(Point const &center, float radius,
+                                float startAngle, float sweep) -> MaybeArc;
+
+            /** @returns the point at @param u, which runs from the start of
+             *           the Arc at `u = 0` to its end at `u = 1`
+             */
+            auto atU(float u) const -> Point;
+
+            /** @returns the length of the Arc itself, not of its chord
+             */
+            auto length() const -> float;
+
+            auto center() const -> Point const &;
+            auto radius() const -> float;
+            auto startAngle() const -> float;
+            auto sweep() const -> float;
+
+            /** @returns true if the Arc is a whole circle
+             */
+            auto closed() const -> bool;
+
+            auto operator==(Arc const&) const -> bool = default;
+        private:
+            Arc(Point const &center, float radius, float startAngle, float sweep);
+
+            Point middle;
+            float r, start, turn;
+    };
+
+    /** @brief a whole circle, centred on @param center and lying in the plane
+     *         through it that is parallel to XY
+     *
+     *  @returns a Circle if @param radius is positive
+     */
+    auto makeCircle(Point const &center, float radius) -> MaybeCircle;
+
+    class Circle {
+        public:
+            friend auto makeCircle(Point const &center, float radius) -> MaybeCircle;
+
+            /** @returns the point at @param u, going counter-clockwise once
+             *           around from the positive x direction
+             */
+            auto atU(float u) const -> Point;
+
+            auto length() const -> float;
+
+            auto center() const -> Point const &;
+            auto radius() const -> float;
+
+            /** @returns the Circle as a closed Arc, starting at angle zero
+             */
+            auto asArc() const -> Arc;
+
+            auto operator==(Circle const&) const -> bool = default;
+        private:
+            Circle(Point const &center, float radius);
+
+            Point middle;
+            float r;
+    };
+
+    template <typename T>
+    auto operator<<(std::ostream &stream, BasicPoint<T> const &p) -> std::ostream &;
+
+    template <typename T>
+    auto operator<<(std::ostream &stream, BasicLine<T> const &line)-> std::ostream &;
+
+    // Instantiated in the library, so that there are out-of-line copies of
+    // everything above even though some of it is also inline
+    extern template struct BasicPoint<float>;
+    extern template struct BasicPoint<double>;
+    extern template class BasicLine<float>;
+    extern template class BasicLine<double>;
+
+    extern template auto makeLine<float>(Point const &p1, Point const &p2) -> MaybeLine;
+    extern template auto makeLine<double>(PointD const &p1, PointD const &p2) -> MaybeLineD;
+
+    extern template auto operator<<(std::ostream &stream, Point const &p) -> std::ostream &;
+    extern template auto operator<<(std::ostream &stream, PointD const &p) -> std::ostream &;
+    extern template auto operator<<(std::ostream &stream, Line const &line) -> std::ostream &;
+    extern template auto operator<<(std::ostream &stream, LineD const &line) -> std::ostream &;
+
+    auto operator<<(std::ostream &stream, Arc const &arc) -> std::ostream &;
+    auto operator<<(std::ostream &stream, Circle const &circle) -> std::ostream &;
 
 } // namespace mycad
 
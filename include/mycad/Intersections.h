@@ -0,0 +1,52 @@
+#ifndef MYCAD_INTERSECTIONS_HEADER
+#define MYCAD_INTERSECTIONS_HEADER
+
+#include "mycad/Entity.h"
+#include "mycad/Types.h"
+
+#include <vector>
+
+namespace mycad
+{
+    /** @brief a place where two Edges meet, found by findIntersections
+     */
+    struct Intersection
+    {
+        // Always Intersection#first < Intersection#second
+        EdgeID first, second;
+
+        // Where the Edges meet, as a parameter along each one's Line (see
+        // Line::atU)
+        float u1, u2;
+
+        // True if the Edges are collinear and overlap. Each overlap is
+        // reported twice, once for each end of the part the Edges share.
+        bool overlapping;
+
+        auto operator<=>(Intersection const&) const = default;
+    };
+
+    using Intersections = std::vector<Intersection>;
+
+    /** @brief finds every place where two Edges of @param entity meet in the
+     *         XY plane
+     *
+     *  This includes Edges that cross, Edges that touch (one ends on the
+     *  other) and collinear Edges that overlap, but not Edges that merely
+     *  share a Vertex. Like Entity::findFaces, the z coordinates are ignored.
+     *
+     *  The Lines are first bucketed into a uniform grid, so only Lines that
+     *  share a cell are compared. Each pair is then tested exactly with
+     *  mycad::orient2d, so touching and collinear cases are never missed or
+     *  invented by rounding; only the reported parameters are rounded.
+     *
+     *  The comparisons are shared between @param threads threads (zero means
+     *  one per hardware thread), and the result is the same whatever the
+     *  number.
+     *
+     *  @returns the Intersections sorted by Edge, then by Intersection#u1
+     */
+    auto findIntersections(Entity const &entity, unsigned threads = 1) -> Intersections;
+} // namespace mycad
+
+#endif // MYCAD_INTERSECTIONS_HEADER
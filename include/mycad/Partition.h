@@ -0,0 +1,49 @@
+#ifndef MYCAD_PARTITION_HEADER
+#define MYCAD_PARTITION_HEADER
+
+#include "mycad/Types.h"
+#include "mycad/Topology.h"
+
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace mycad
+{
+    /** @brief a split of a Topology in to parts that can be worked on
+     *         independently
+     */
+    struct Partition
+    {
+        // the part each Vertex belongs to, indexed by VertexID
+        std::vector<std::size_t> vertexParts;
+
+        // the part each Edge belongs to: the part of its first Vertex
+        std::map<EdgeID, std::size_t> edgeParts;
+
+        // the Edges belonging to each part, indexed by part
+        std::vector<EdgeIDs> partEdges;
+
+        // the Edges whose two Vertices are in different parts
+        EdgeIDs boundaryEdges;
+    };
+
+    using MaybePartition = std::optional<Partition>;
+
+    /** @brief splits a Topology in to @param nParts parts with roughly the
+     *         same number of Edges each, and as few Edges between parts as
+     *         possible
+     *
+     *  The parts are grown breadth-first, so each one is a connected "slab" of
+     *  the Topology wherever possible. A few passes of greedy refinement then
+     *  move boundary Vertices to whichever neighbouring part shares the most
+     *  Edges with them, as long as that doesn't unbalance the parts.
+     *
+     *  Some parts may be empty if there are fewer Vertices than parts.
+     *
+     *  @returns std::nullopt if @param nParts is zero
+     */
+    auto partition(Topology const &topo, std::size_t nParts) -> MaybePartition;
+} // namespace mycad
+
+#endif // MYCAD_PARTITION_HEADER
@@ -0,0 +1,118 @@
+#ifndef MYCAD_POINT_ARRAY_HEADER
+#define MYCAD_POINT_ARRAY_HEADER
+
+#include "mycad/BoundingBox.h"
+#include "mycad/Geometry.h"
+#include "mycad/detail/AlignedAllocator.h"
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace mycad
+{
+    /** @brief a 4x4 matrix in row-major order
+     *
+     *  Points are treated as column vectors, so the translation lives in
+     *  elements 3, 7 and 11.
+     */
+    using Matrix4 = std::array<float, 16>;
+
+    /** @brief a collection of Points stored as a "structure of arrays"
+     *
+     *  The x, y and z components are kept in three separate lanes, each aligned
+     *  to a cache line and padded to a whole number of SIMD vectors. Bulk
+     *  operations therefore run at full SIMD width with no unaligned or
+     *  partial loads, which makes this the container to use when the same
+     *  operation is applied to a lot of Points.
+     */
+    class PointArray
+    {
+        public:
+            PointArray() = default;
+            explicit PointArray(std::span<Point const> points);
+
+            auto operator==(PointArray const &other) const -> bool;
+
+            auto size() const -> std::size_t;
+            auto empty() const -> bool;
+            auto reserve(std::size_t n) -> void;
+            auto clear() -> void;
+
+            auto append(Point const &p) -> void;
+
+            /** @brief keeps the first @param n Points, or adds Points at the
+             *         origin until there are @param n
+             */
+            auto resize(std::size_t n) -> void;
+
+            /** @returns the Point at @param i
+             *
+             *  @throws std::out_of_range unless @param i is less than size()
+             */
+            auto at(std::size_t i) const -> Point;
+
+            /** @brief replaces the Point at @param i
+             *
+             *  @throws std::out_of_range unless @param i is less than size()
+             */
+            auto set(std::size_t i, Point const &p) -> void;
+
+            /** @brief the x components, one per Point
+             */
+            auto xs() const -> std::span<float const>;
+            auto ys() const -> std::span<float const>;
+            auto zs() const -> std::span<float const>;
+
+            /** @brief applies @param m to every Point
+             *
+             *  Only the top three rows are used, i.e. the bottom row is assumed
+             *  to be (0, 0, 0, 1)
+             */
+            auto transform(Matrix4 const &m) -> void;
+
+            /** @brief moves every Point by @param offset
+             */
+            auto translate(Point const &offset) -> void;
+
+            /** @brief scales every Point by @param factor, towards or away
+             *         from @param origin
+             */
+            auto scale(float factor, Point const &origin = {0, 0, 0}) -> void;
+
+            /** @returns the smallest box containing every Point, or
+             *           std::nullopt if there aren't any
+             */
+            auto bounds() const -> MaybeBoundingBox;
+
+            /** @returns the smallest box containing every Point whose entry
+             *           in @param mask is non-zero, or std::nullopt if there
+             *           aren't any
+             *
+             *  @param mask has one entry per Point. This is still a SIMD
+             *  reduction, with the masked-out Points blended away.
+             *
+             *  @throws std::out_of_range if @param mask is shorter than size()
+             */
+            auto bounds(std::span<float const> mask) const -> MaybeBoundingBox;
+
+            /** @brief writes the distance from each Point to @param p to the
+             *         start of @param out
+             *  @returns false, without writing anything, if @param out is
+             *           smaller than size()
+             */
+            auto distancesTo(Point const &p, std::span<float> out) const -> bool;
+
+            using Lane = std::vector<float, detail::AlignedAllocator<float, 64>>;
+        private:
+            // Resizes the lanes for @param n Points, plus padding
+            auto resizeLanes(std::size_t n) -> void;
+
+            std::size_t count = 0;
+            Lane x{}, y{}, z{};
+    };
+
+    auto operator<<(std::ostream &stream, PointArray const &points) -> std::ostream &;
+} // namespace mycad
+
+#endif // MYCAD_POINT_ARRAY_HEADER
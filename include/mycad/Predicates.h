@@ -0,0 +1,74 @@
+#ifndef MYCAD_PREDICATES_HEADER
+#define MYCAD_PREDICATES_HEADER
+
+#include "mycad/Geometry.h"
+
+namespace mycad
+{
+    /** @brief the sign of a geometric determinant
+     */
+    enum class Orientation
+    {
+        Negative  = -1,
+        Zero      =  0,
+        Positive  =  1
+    };
+
+    /** @brief which side of the line from @param a to @param b @param c is on,
+     *         looking down the z axis
+     *
+     *  @returns Orientation::Positive if a → b → c turns counter-clockwise,
+     *           Orientation::Negative if it turns clockwise and
+     *           Orientation::Zero if the three are collinear
+     *
+     *  The answer is always exact. The determinant is first evaluated in
+     *  plain floating point along with a bound on its error; only if the
+     *  result is too close to zero to trust is it evaluated again with exact
+     *  (expansion) arithmetic. z is ignored.
+     */
+    auto orient2d(Point const &a, Point const &b, Point const &c) -> Orientation;
+
+    /** @brief which side of the plane through @param a, @param b and @param c
+     *         @param d is on
+     *
+     *  @returns Orientation::Positive if @param d is below the plane, i.e. if
+     *           a → b → c is counter-clockwise when viewed from above it,
+     *           Orientation::Negative if it's above, and Orientation::Zero if
+     *           the four are coplanar
+     *
+     *  Like orient2d, this is exact and only falls back to exact arithmetic
+     *  when the fast path can't decide.
+     */
+    auto orient3d(Point const &a, Point const &b, Point const &c, Point const &d)
+        -> Orientation;
+
+    /** @returns true if the three points lie exactly on a single line
+     */
+    auto collinear(Point const &a, Point const &b, Point const &c) -> bool;
+
+    /** @returns true if @param p lies exactly on @param line between its two
+     *           ends (inclusive)
+     */
+    auto onSegment(Line const &line, Point const &p) -> bool;
+
+    /** @returns true if @param p is no further than @param tolerance from the
+     *           part of @param line between its two ends
+     */
+    auto onSegment(Line const &line, Point const &p, float tolerance) -> bool;
+
+    /** @returns true if the two points are no further than @param tolerance
+     *           apart
+     */
+    auto coincident(Point const &a, Point const &b, float tolerance) -> bool;
+
+    /** @returns true if both Lines lie exactly on the same infinite line
+     */
+    auto coincident(Line const &a, Line const &b) -> bool;
+
+    /** @returns true if both ends of each Line are no further than
+     *           @param tolerance from the (infinite) other Line
+     */
+    auto coincident(Line const &a, Line const &b, float tolerance) -> bool;
+} // namespace mycad
+
+#endif // MYCAD_PREDICATES_HEADER
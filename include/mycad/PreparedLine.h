@@ -0,0 +1,86 @@
+#ifndef MYCAD_PREPARED_LINE_HEADER
+#define MYCAD_PREPARED_LINE_HEADER
+
+#include "mycad/BoundingBox.h"
+#include "mycad/Geometry.h"
+
+namespace mycad
+{
+    /** @brief a Line along with everything that queries against it keep
+     *         re-computing
+     *
+     *  The direction, squared length, inverse length and bounding box are
+     *  worked out once, when the PreparedLine is made. After that, projecting,
+     *  finding the closest point and testing containment need no divisions
+     *  or square roots, which is what makes it worth holding on to one when
+     *  the same Line is queried many times (e.g. inside a spatial index).
+     *
+     *  A PreparedLine is a copy, so it doesn't follow later changes to the
+     *  Line it was made from.
+     */
+    class PreparedLine
+    {
+        public:
+            explicit PreparedLine(Line const &line);
+
+            auto line() const -> Line const &;
+
+            /** @brief the same as Line::atU
+             */
+            auto atU(float u) const -> Point;
+
+            /** @returns the vector from the start of the Line to its end
+             */
+            auto direction() const -> Point const &;
+            auto lengthSquared() const -> float;
+            auto length() const -> float;
+            auto inverseLength() const -> float;
+            auto box() const -> BoundingBox const &;
+
+            /** @returns the u (see Line::atU) of the point on the infinite line
+             *           that is closest to @param p
+             */
+            auto project(Point const &p) const -> float;
+
+            /** @returns the point between the two ends of the Line that is
+             *           closest to @param p
+             */
+            auto closestPoint(Point const &p) const -> Point;
+
+            /** @returns the squared distance from @param p to closestPoint
+             */
+            auto distanceSquared(Point const &p) const -> float;
+            auto distance(Point const &p) const -> float;
+
+            /** @returns true if @param p is no further than @param tolerance
+             *           from the part of the Line between its two ends
+             *
+             *  This is the same test as mycad::onSegment, but in single
+             *  precision, and a Point outside the box grown by @param
+             *  tolerance is rejected without doing any arithmetic.
+             */
+            auto contains(Point const &p, float tolerance) const -> bool;
+
+            /** @returns true if any part of the Line is inside or on the
+             *           surface of @param other
+             */
+            auto crosses(BoundingBox const &other) const -> bool;
+        private:
+            Line source;
+
+            Point start;
+            Point delta;
+
+            // One over each component of PreparedLine#delta, which is
+            // infinite for a component that is zero
+            Point inverseDelta;
+
+            float squaredLength;
+            float inverseSquaredLength;
+            float oneOverLength;
+
+            BoundingBox bounds;
+    };
+} // namespace mycad
+
+#endif // MYCAD_PREPARED_LINE_HEADER
@@ -0,0 +1,45 @@
+#ifndef MYCAD_SIMPLIFY_HEADER
+#define MYCAD_SIMPLIFY_HEADER
+
+#include "mycad/Entity.h"
+#include "mycad/Geometry.h"
+#include "mycad/Types.h"
+
+#include <span>
+#include <vector>
+
+namespace mycad
+{
+    using Polyline = std::vector<Point>;
+
+    /** @brief drops the Points of @param points that add little to its shape,
+     *         e.g. to draw a detailed sketch at a lower level of detail
+     *
+     *  This is Visvalingam–Whyatt simplification, except that each Point is
+     *  measured by its distance from the segment between its two neighbours
+     *  rather than by the area of the triangle they make, so that
+     *  @param tolerance is a distance (and can be e.g. half a pixel). The Point
+     *  with the smallest distance is dropped, its neighbours are measured
+     *  again, and so on until every remaining Point is further away than
+     *  @param tolerance.
+     *
+     *  The first and last Points are always kept, so a closed polyline stays
+     *  closed. This runs in O(n log n).
+     */
+    auto simplify(std::span<Point const> points, float tolerance) -> Polyline;
+
+    /** @brief simplifies the Points along each of @param chains, without
+     *         changing @param entity
+     *
+     *  The Chains are shared out between @param threads threads; the result
+     *  is the same whatever the number. Zero means one per hardware thread,
+     *  but with enough Chains each that a few are done on the calling thread.
+     *
+     *  @returns one Polyline per Chain, in the same order, which is empty if
+     *           the Chain doesn't exist
+     */
+    auto simplifyChains(Entity const &entity, std::span<Chain const> chains,
+                        float tolerance, unsigned threads = 0) -> std::vector<Polyline>;
+} // namespace mycad
+
+#endif // MYCAD_SIMPLIFY_HEADER
@@ -0,0 +1,236 @@
+#ifndef MYCAD_SPATIAL_INDEX_HEADER
+#define MYCAD_SPATIAL_INDEX_HEADER
+
+#include "mycad/Geometry.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace mycad
+{
+    /** @brief a Point found by a spatial query
+     */
+    struct Neighbour
+    {
+        // Whatever the Point was added with, e.g. its VertexID
+        std::size_t id;
+        float distance;
+
+        auto operator<=>(Neighbour const&) const = default;
+    };
+
+    using MaybeNeighbour = std::optional<Neighbour>;
+    using Neighbours     = std::vector<Neighbour>;
+
+    /** @brief Points hashed into a uniform grid of cubic cells
+     *
+     *  Inserting, moving and removing a Point are all O(1), and a query only
+     *  looks at the cells around it, so this suits interactive work such as
+     *  snapping the cursor to the nearest Vertex while the drawing changes
+     *  underneath it. Queries are fastest when the cell size is about the
+     *  same as the query radius.
+     *
+     *  Cells are hashed by all three of their coordinates, so the grid works
+     *  as well far from the origin (e.g. at survey coordinates in the
+     *  millions) as it does near it.
+     *
+     *  Each Point is identified by an id chosen by the caller. These are used
+     *  as indices, so they should be small and dense, like VertexIDs.
+     */
+    class PointGrid
+    {
+        public:
+            /** @param cellSize the length of the side of each cell, which
+             *         must be more than zero
+             */
+            explicit PointGrid(float cellSize);
+
+            auto size() const -> std::size_t;
+            auto contains(std::size_t id) const -> bool;
+
+            /** @brief makes room for ids up to @param n, in as many cells
+             */
+            auto reserve(std::size_t n) -> void;
+
+            /** @returns false, without changing anything, if @param id is
+             *           already in the grid
+             */
+            auto insert(std::size_t id, Point const &p) -> bool;
+
+            /** @returns false if @param id isn't in the grid
+             */
+            auto remove(std::size_t id) -> bool;
+
+            /** @brief moves @param id to @param p
+             *  @returns false if @param id isn't in the grid
+             */
+            auto move(std::size_t id, Point const &p) -> bool;
+
+            /** @returns the closest Point to @param p that is no further away
+             *           than @param maxDistance
+             */
+            auto nearest(Point const &p,
+                         float maxDistance = std::numeric_limits<float>::infinity())
+                const -> MaybeNeighbour;
+
+            /** @returns every Point no further than @param radius from
+             *           @param p, in no particular order
+             */
+            auto withinRadius(Point const &p, float radius) const -> Neighbours;
+
+            /** @brief nearest() for every Point in @param queries at once
+             *
+             *  The queries are answered in cell order, so that neighbouring
+             *  queries share the cells they look at. The results are written
+             *  to the start of @param out in the same order as @param queries.
+             *
+             *  @returns false, without writing anything, if @param out is
+             *           smaller than @param queries
+             */
+            auto nearest(std::span<Point const> queries,
+                         std::span<MaybeNeighbour> out,
+                         float maxDistance = std::numeric_limits<float>::infinity())
+                const -> bool;
+        private:
+            struct Cell
+            {
+                std::int64_t x, y, z;
+
+                auto operator<=>(Cell const&) const = default;
+            };
+
+            struct CellHash
+            {
+                auto operator()(Cell const &c) const -> std::size_t;
+            };
+
+            auto cellOf(Point const &p) const -> Cell;
+
+            // Keep low and high fitted to the occupied cells as @param c
+            // becomes occupied or empty
+            auto occupy(Cell const &c) -> void;
+            auto vacate(Cell const &c) -> void;
+
+            float cellSize;
+            std::size_t count = 0;
+
+            // The first id in each occupied cell, and the smallest range of
+            // cells covering all of them. The range is kept tight by counting
+            // the occupied cells at each coordinate along each axis.
+            std::unordered_map<Cell, std::size_t, CellHash> cells{};
+            Cell low{0, 0, 0}, high{-1, -1, -1};
+            std::array<std::unordered_map<std::int64_t, std::size_t>, 3> occupied{};
+
+            // Indexed by id. The ids in each cell are linked through next,
+            // so that a cell doesn't need a container of its own.
+            std::vector<Point> positions{};
+            std::vector<bool> present{};
+            std::vector<std::size_t> next{};
+    };
+
+    /** @brief a balanced k-d tree over a set of Points
+     *
+     *  The tree is stored implicitly: the Points are arranged so that the
+     *  median of each range splits it, and there are no nodes or pointers.
+     *  Building it is O(n log n) and queries are O(log n), which makes this the
+     *  better choice for bulk nearest-neighbour work over a set of Points that
+     *  doesn't change much.
+     *
+     *  It can still change: inserted Points are kept to one side and searched
+     *  linearly, and removed ones are only marked as such, until there are
+     *  enough of either to make re-building the tree worthwhile.
+     */
+    class KdTree
+    {
+        public:
+            KdTree() = default;
+
+            /** @brief builds a tree over @param points, with ids counting up
+             *         from zero
+             */
+            explicit KdTree(std::span<Point const> points);
+
+            auto size() const -> std::size_t;
+            auto contains(std::size_t id) const -> bool;
+
+            /** @returns false, without changing anything, if @param id is
+             *           already in the tree
+             */
+            auto insert(std::size_t id, Point const &p) -> bool;
+
+            /** @returns false if @param id isn't in the tree
+             */
+            auto remove(std::size_t id) -> bool;
+
+            /** @returns the closest Point to @param p that is no further away
+             *           than @param maxDistance
+             */
+            auto nearest(Point const &p,
+                         float maxDistance = std::numeric_limits<float>::infinity())
+                const -> MaybeNeighbour;
+
+            /** @returns the @param k closest Points to @param p, closest first
+             */
+            auto kNearest(Point const &p, std::size_t k) const -> Neighbours;
+
+            /** @returns every Point no further than @param radius from
+             *           @param p, in no particular order
+             */
+            auto withinRadius(Point const &p, float radius) const -> Neighbours;
+
+            /** @brief nearest() for every Point in @param queries at once
+             *
+             *  The results are written to the start of @param out.
+             *
+             *  @returns false, without writing anything, if @param out is
+             *           smaller than @param queries
+             */
+            auto nearest(std::span<Point const> queries,
+                         std::span<MaybeNeighbour> out,
+                         float maxDistance = std::numeric_limits<float>::infinity())
+                const -> bool;
+        private:
+            enum class State : std::uint8_t
+            {
+                Absent, InTree, Pending
+            };
+
+            struct Entry
+            {
+                Point p;
+                std::size_t id;
+            };
+
+            // Arranges @param entries[first, last) into a subtree
+            auto build(std::vector<Entry> &entries,
+                       std::size_t first, std::size_t last) -> void;
+            auto rebuild() -> void;
+
+            // Calls @param visit(slot, squaredDistance) for each live Point in
+            // the tree that might be within sqrt(@param bound) of @param p.
+            // @param bound may shrink as the search goes on.
+            template <typename Visit>
+            auto search(Point const &p, float const &bound, Visit &&visit) const -> void;
+
+            // In tree order
+            std::vector<Point> points{};
+            std::vector<std::size_t> ids{};
+            std::vector<std::uint8_t> axes{};
+            std::vector<bool> dead{};
+            std::size_t deadCount = 0;
+
+            std::vector<Entry> pending{};
+
+            // Indexed by id. A slot is a position in the tree, or in pending
+            // for a Pending id.
+            std::vector<State> states{};
+            std::vector<std::size_t> slots{};
+    };
+} // namespace mycad
+
+#endif // MYCAD_SPATIAL_INDEX_HEADER
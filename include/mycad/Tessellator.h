@@ -0,0 +1,103 @@
+#ifndef MYCAD_TESSELLATOR_HEADER
+#define MYCAD_TESSELLATOR_HEADER
+
+#include "mycad/Geometry.h"
+
+#include <map>
+#include <span>
+#include <vector>
+
+namespace mycad
+{
+    /** @returns how many straight segments are needed to draw an Arc of
+     *           @param radius turning through @param sweep, so that no point
+     *           on the Arc is more than @param tolerance from its chord
+     *
+     *  A whole circle always gets at least three segments, and nothing gets
+     *  more than 65536.
+     */
+    auto segmentCount(float radius, float sweep, float tolerance) -> std::size_t;
+
+    /** @brief turns Arcs and Circles into polylines for display, caching the
+     *         results
+     *
+     *  The tolerance is given in pixels and converted to world units with the
+     *  current scale, so zooming in gives smoother curves. Tolerances are
+     *  rounded down to a power of two (a "band"), and each polyline is cached
+     *  per shape and band, so small changes of zoom don't re-tessellate
+     *  anything. Only the current band and the one either side of it are
+     *  kept: zooming further than that evicts the rest, so panning and
+     *  zooming across a large drawing doesn't grow the cache without bound.
+     *
+     *  The cached polylines are relative to the centre of the curve, so every
+     *  curve with the same radius and angles shares one: a drawing with
+     *  thousands of identical holes tessellates one of them, once. This also
+     *  suits instanced drawing, where profile() is uploaded once and drawn
+     *  at each centre.
+     *
+     *  A Tessellator is not safe to use from several threads at once.
+     */
+    class Tessellator
+    {
+        public:
+            /** @param pixelTolerance the largest allowed gap between a curve
+             *         and its polyline, in pixels
+             *  @param pixelsPerUnit the current scale of the view
+             */
+            explicit Tessellator(float pixelTolerance = 0.25f, float pixelsPerUnit = 1);
+
+            /** @brief changes the scale of the view
+             *
+             *  Polylines for the new band and its two neighbours stay cached,
+             *  so zooming back and forth a little re-uses them. Every other
+             *  band is thrown away.
+             */
+            auto setScale(float pixelsPerUnit) -> void;
+
+            /** @returns the tolerance actually used, in world units, after
+             *           rounding down to its band
+             */
+            auto tolerance() const -> float;
+
+            /** @returns the polyline for @param arc, relative to its centre,
+             *           from the start of the Arc to its end
+             *
+             *  The span stays valid until clear() is called, or setScale()
+             *  moves more than one band away from the current one.
+             */
+            auto profile(Arc const &arc) -> std::span<Point const>;
+
+            /** @returns the polyline for @param circle, relative to its
+             *           centre, with the last point the same as the first
+             */
+            auto profile(Circle const &circle) -> std::span<Point const>;
+
+            /** @brief appends the polyline for @param arc, in world
+             *         coordinates, to @param out
+             */
+            auto tessellate(Arc const &arc, std::vector<Point> &out) -> void;
+            auto tessellate(Circle const &circle, std::vector<Point> &out) -> void;
+
+            /** @returns the number of polylines in the cache
+             */
+            auto cacheSize() const -> std::size_t;
+            auto clear() -> void;
+        private:
+            struct Shape
+            {
+                float radius, startAngle, sweep;
+
+                auto operator<=>(Shape const&) const = default;
+            };
+
+            auto band() const -> int;
+
+            // the polylines of each band, by band
+            std::map<int, std::map<Shape, std::vector<Point>>> cache{};
+
+            float pixelTolerance;
+            float pixelsPerUnit;
+    };
+} // namespace mycad
+
+#endif // MYCAD_TESSELLATOR_HEADER
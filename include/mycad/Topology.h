@@ -6,12 +6,24 @@
 
 #include <map>
 #include <list>
+#include <span>
 #include <string>
 #include <utility> // std::pair
 #include <vector>
 
 namespace mycad
 {
+    /** @brief where each ID went when a Topology (or Entity) was compacted
+     *
+     *  Both are indexed by the old ID, and hold std::nullopt for an ID that
+     *  had been deleted.
+     */
+    struct IDRemap
+    {
+        std::vector<MaybeVertexID> vertices;
+        std::vector<MaybeEdgeID> edges;
+    };
+
     class Topology
     {
         public:
@@ -25,6 +37,15 @@ namespace mycad
             auto hasEdge(EdgeID e) const -> bool;
             auto hasChain(Chain c) const -> bool;
 
+            /** @brief VertexIDs are always less than this, which makes it
+             *         suitable for sizing per-Vertex storage
+             */
+            auto vertexCount() const -> std::size_t;
+
+            /** @returns every Edge in the topology, in ascending order
+             */
+            auto edgeIDs() const -> EdgeIDs;
+
             /** @brief A 'free' vertex does is not adajacent to anything
              */
             auto addFreeVertex() -> VertexID;
@@ -58,6 +79,16 @@ namespace mycad
              */
             auto edgesAdjacentToVertex(VertexID v) const -> MaybeEdgeIDs;
 
+            /** @brief a non-allocating view of the adjacency of a Vertex
+             *
+             *  There is one Link for each adjacent Edge (two for a loop Edge).
+             *  The span is invalidated by any edit to the Topology.
+             *
+             *  @returns an empty span if the Vertex does not exist in the
+             *           topology
+             */
+            auto linksAt(VertexID v) const -> std::span<detail::Link const>;
+
             /** @returns A pair `(left, right)` of vertex IDs corresponding to
              *           this Edge
              *  @returns invalid Vertices if the provided Edge does not exist in
@@ -85,8 +116,65 @@ namespace mycad
              */
             auto deleteEdge(EdgeID e) -> bool;
 
+            /** @brief deletes @param v and every Edge adjacent to it
+             *
+             *  VertexIDs are never reused, so the other Vertices keep theirs
+             *  and vertexCount() doesn't go down.
+             *
+             *  @returns false if the Vertex doesn't exist
+             */
+            auto deleteVertex(VertexID v) -> bool;
+
+            /** @brief renumbers the Vertices and Edges so that there are no
+             *         gaps left by deleted ones
+             *
+             *  Deleted IDs are otherwise never reused, so this is how storage
+             *  indexed by ID is kept in proportion to what's left after a lot
+             *  of deleting. IDs keep their order, and Links keep their
+             *  position on each Vertex, so a Chain only needs its whichVertex
+             *  mapping. A Link that led on to a deleted Edge is cut.
+             *
+             *  This is O(V + E log E).
+             *
+             *  @returns the mapping from old IDs to new ones, or std::nullopt
+             *           if a batch is open
+             */
+            auto compact() -> std::optional<IDRemap>;
+
+            /** @brief starts a batch of edits
+             *
+             *  While a batch is open every edit is journaled so that the whole
+             *  batch can be undone, and updates to the Edge index are deferred
+             *  until commit() merges (or rebuilds) it in one go.
+             *
+             *  @returns false if a batch is already open
+             */
+            auto beginBatch() -> bool;
+
+            /** @brief keeps every edit made since beginBatch()
+             *  @returns false if no batch is open
+             */
+            auto commit() -> bool;
+
+            /** @brief undoes every edit made since beginBatch()
+             *
+             *  The Topology is restored to exactly the state it was in when the
+             *  batch was started, including its ID counters.
+             *
+             *  @returns false if no batch is open
+             */
+            auto rollback() -> bool;
+
+            auto inBatch() const -> bool;
+
             auto streamTo(std::ostream &os) const -> void;
         private:
+            /** @returns the Edge between the two Vertices, in either order
+             */
+            auto findEdge(VertexID v1, VertexID v2) const -> MaybeEdgeID;
+
+            auto undo(detail::Undo const &u) -> void;
+
             // std::vector::size can't be relied upon for UID's since when
             // items are deleted the size scales appropriately.
             int lastVertexID = 0;
@@ -94,6 +182,9 @@ namespace mycad
 
             detail::Vertices vertices{};
             std::map<EdgeID, detail::Edge> edges{};
+            detail::EdgeIndex edgeIndex{};
+
+            std::optional<detail::Batch> batch{};
     };
 
 
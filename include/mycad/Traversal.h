@@ -0,0 +1,134 @@
+#ifndef MYCAD_TRAVERSAL_HEADER
+#define MYCAD_TRAVERSAL_HEADER
+
+#include "mycad/Types.h"
+#include "mycad/Topology.h"
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <utility> // std::pair
+#include <vector>
+
+namespace mycad
+{
+    /** @brief the cost of walking across an Edge, see weightedShortestPath
+     */
+    using EdgeWeight = std::function<float(EdgeID)>;
+
+    /** @brief caller-owned state that is re-used from one traversal to the next
+     *
+     *  Rather than clearing a "visited" flag for every Vertex before each
+     *  query, every mark is stamped with the epoch of the traversal that made
+     *  it. Starting a new traversal just bumps the epoch, so repeated queries
+     *  neither clear nor reallocate anything proportional to the size of the
+     *  Topology. The buffers only ever grow, to fit the largest Topology the
+     *  scratch has been used with.
+     */
+    class TraversalScratch
+    {
+        public:
+            /** @returns true if @param v was reached by the last traversal
+             */
+            auto isVisited(VertexID v) const -> bool;
+
+            /** @returns the number of Edges between the start of the last
+             *           breadthFirst traversal and @param v, or std::nullopt if
+             *           @param v wasn't reached
+             */
+            auto depth(VertexID v) const -> std::optional<std::size_t>;
+
+            /** @returns the Vertices reached by the last traversal, in the
+             *           order they were reached
+             */
+            auto order() const -> std::span<VertexID const>;
+
+            friend auto breadthFirst(Topology const &topo, VertexID start,
+                                     TraversalScratch &scratch,
+                                     std::size_t maxDepth)
+                -> std::span<VertexID const>;
+
+            friend auto shortestPath(Topology const &topo,
+                                     VertexID from, VertexID to,
+                                     TraversalScratch &scratch) -> MaybeEdgeIDs;
+
+            friend auto weightedShortestPath(Topology const &topo,
+                                             VertexID from, VertexID to,
+                                             TraversalScratch &scratch,
+                                             EdgeWeight const &weight)
+                -> MaybeEdgeIDs;
+        private:
+            /** @brief starts a new traversal of a Topology with @param nVertices
+             */
+            auto start(std::size_t nVertices) -> void;
+
+            /** @brief marks @param v as reached through @param via
+             *  @returns false if @param v had already been reached
+             */
+            auto reach(VertexID v, std::pair<VertexID, EdgeID> via,
+                       std::size_t depth) -> bool;
+
+            /** @brief walks the recorded parents back from @param to
+             */
+            auto pathTo(VertexID from, VertexID to) const -> EdgeIDs;
+
+            std::uint32_t epoch = 0;
+
+            // indexed by VertexID
+            std::vector<std::uint32_t> reached{};
+            std::vector<std::uint32_t> settled{};
+            std::vector<std::size_t> depths{};
+            std::vector<float> distances{};
+            std::vector<std::pair<VertexID, EdgeID>> parents{};
+
+            // doubles as the queue for breadth-first traversals
+            std::vector<VertexID> visitOrder{};
+            std::vector<std::pair<float, VertexID>> heap{};
+    };
+
+    /** @brief visits every Vertex reachable from @param start, nearest first
+     *
+     *  @param maxDepth stops the traversal after this many Edges
+     *
+     *  @returns the Vertices that were reached, in order, starting with
+     *           @param start. The span points in to @param scratch and is only
+     *           valid until it is used again.
+     *  @returns an empty span if @param start does not exist in the Topology
+     */
+    auto breadthFirst(Topology const &topo, VertexID start,
+                      TraversalScratch &scratch,
+                      std::size_t maxDepth = std::numeric_limits<std::size_t>::max())
+        -> std::span<VertexID const>;
+
+    /** @brief every Vertex at most @param rings Edges away from @param v
+     *
+     *  The result is ordered by ring, and TraversalScratch::depth says which
+     *  ring each Vertex belongs to.
+     */
+    auto ringNeighbourhood(Topology const &topo, VertexID v, std::size_t rings,
+                           TraversalScratch &scratch)
+        -> std::span<VertexID const>;
+
+    /** @brief the path with the fewest Edges between two Vertices
+     *
+     *  @returns the Edges walked from @param from to @param to, in order
+     *  @returns an empty vector if @param from and @param to are the same
+     *  @returns std::nullopt if either Vertex doesn't exist or @param to can't
+     *           be reached from @param from
+     */
+    auto shortestPath(Topology const &topo, VertexID from, VertexID to,
+                      TraversalScratch &scratch) -> MaybeEdgeIDs;
+
+    /** @brief the path with the smallest total @param weight between two
+     *         Vertices
+     *
+     *  Every weight must be non-negative. Otherwise, this behaves the same as
+     *  shortestPath.
+     */
+    auto weightedShortestPath(Topology const &topo, VertexID from, VertexID to,
+                              TraversalScratch &scratch,
+                              EdgeWeight const &weight) -> MaybeEdgeIDs;
+} // namespace mycad
+
+#endif // MYCAD_TRAVERSAL_HEADER
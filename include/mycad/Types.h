@@ -6,7 +6,16 @@
 
 namespace mycad
 {
-    class Line;
+    template <typename T> struct BasicPoint;
+    template <typename T> class BasicLine;
+
+    using Point  = BasicPoint<float>;
+    using PointD = BasicPoint<double>;
+    using Line   = BasicLine<float>;
+    using LineD  = BasicLine<double>;
+
+    class Arc;
+    class Circle;
 
     using Lines        = std::vector<Line>;
     using VertexID     = std::size_t;
@@ -21,6 +30,9 @@ namespace mycad
     };
 
     using MaybeLine         = std::optional<Line>;
+    using MaybeLineD        = std::optional<LineD>;
+    using MaybeArc          = std::optional<Arc>;
+    using MaybeCircle       = std::optional<Circle>;
     using MaybeVertexID     = std::optional<VertexID>;
     using MaybeVertexIDPair = std::optional<VertexIDPair>;
     using MaybeEdgeID       = std::optional<EdgeID>;
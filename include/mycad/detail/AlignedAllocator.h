@@ -0,0 +1,47 @@
+#ifndef MYCAD_ALIGNED_ALLOCATOR_DETAIL_HEADER
+#define MYCAD_ALIGNED_ALLOCATOR_DETAIL_HEADER
+
+#include <cstddef>
+#include <new>
+
+namespace mycad::detail
+{
+    /** @brief a std::allocator that aligns every allocation to @tparam Alignment
+     *         bytes, e.g. so that SIMD loads never straddle a cache line
+     */
+    template <typename T, std::size_t Alignment>
+    struct AlignedAllocator
+    {
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() = default;
+
+        template <typename U>
+        AlignedAllocator(AlignedAllocator<U, Alignment> const &) {}
+
+        auto allocate(std::size_t n) -> T *
+        {
+            return static_cast<T *>(
+                ::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+        }
+
+        auto deallocate(T *p, std::size_t) -> void
+        {
+            ::operator delete(p, std::align_val_t(Alignment));
+        }
+
+        template <typename U>
+        auto operator==(AlignedAllocator<U, Alignment> const &) const -> bool
+        {
+            return true;
+        }
+    };
+} // namespace mycad::detail
+
+#endif // MYCAD_ALIGNED_ALLOCATOR_DETAIL_HEADER
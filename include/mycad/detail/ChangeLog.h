@@ -0,0 +1,64 @@
+#ifndef MYCAD_CHANGE_LOG_DETAIL_HEADER
+#define MYCAD_CHANGE_LOG_DETAIL_HEADER
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mycad
+{
+    /** @brief counts the edits made to an Entity, see Entity::changesSince
+     */
+    using Generation = std::uint64_t;
+}
+
+namespace mycad::detail
+{
+    /** @brief remembers which of a dense set of IDs changed in which
+     *         Generation
+     *
+     *  Each ID is stamped with the Generation it last changed in, and every
+     *  change is also appended to a log, which is therefore sorted by
+     *  Generation. Finding the changes since a Generation is a binary search
+     *  of the log followed by a scan of just the changes after it; entries
+     *  whose ID has changed again since are skipped, and are compacted away
+     *  once they make up half the log.
+     */
+    class ChangeLog
+    {
+        public:
+            /** @brief adds a new ID, one past the last, changed in
+             *         @param generation
+             */
+            auto add(Generation generation) -> void;
+
+            /** @brief records that @param id changed in @param generation,
+             *         which must be at least as late as any before it
+             */
+            auto touch(std::size_t id, Generation generation) -> void;
+
+            /** @brief forgets every ID from @param n onwards
+             */
+            auto truncate(std::size_t n) -> void;
+
+            auto size() const -> std::size_t;
+
+            /** @returns each ID that has changed after @param generation,
+             *           once, in the order of their last change
+             */
+            auto since(Generation generation) const -> std::vector<std::size_t>;
+        private:
+            struct Entry
+            {
+                Generation generation;
+                std::size_t id;
+            };
+
+            auto compact() -> void;
+
+            std::vector<Generation> stamps{};
+            std::vector<Entry> entries{};
+    };
+} // namespace mycad::detail
+
+#endif // MYCAD_CHANGE_LOG_DETAIL_HEADER
@@ -0,0 +1,31 @@
+#ifndef MYCAD_LERP_DETAIL_HEADER
+#define MYCAD_LERP_DETAIL_HEADER
+
+namespace mycad::detail
+{
+    /** @brief std::lerp, but usable in constant expressions
+     *
+     *  This is the same formula std::lerp uses (so it's exact at both ends,
+     *  monotonic, and gives the same results bit for bit), which is also what
+     *  the vectorized Line sampling reproduces.
+     */
+    template <typename T>
+    constexpr auto lerp(T a, T b, T t) -> T
+    {
+        if ((a <= 0 && b >= 0) || (a >= 0 && b <= 0))
+        {
+            return t * b + (1 - t) * a;
+        }
+
+        if (t == 1)
+        {
+            return b;
+        }
+
+        // Don't overshoot b, whichever direction we're going in
+        T const x = a + t * (b - a);
+        return (t > 1) == (b > a) ? (b < x ? x : b) : (x < b ? x : b);
+    }
+} // namespace mycad::detail
+
+#endif // MYCAD_LERP_DETAIL_HEADER
@@ -41,6 +41,56 @@ namespace mycad::detail
 
     using Vertices = std::vector<Vertex>;
 
+    // Edges are indexed by their (smaller, larger) VertexID pair so that
+    // duplicates can be found without scanning every Edge
+    using EdgeIndex = std::map<VertexIDPair, EdgeID>;
+
+    auto orderedEnds(VertexID const v1, VertexID const v2) -> VertexIDPair;
+
+    struct RemovedLink
+    {
+        VertexID vertex = 0;
+        std::size_t position = 0;
+        Link link{};
+
+        auto operator<=>(RemovedLink const &other) const = default;
+    };
+
+    /** @brief everything needed to undo a single edit made during a batch
+     */
+    struct Undo
+    {
+        enum class Kind { AddVertex, MakeEdge, JoinEdges, DeleteEdge, DeleteVertex };
+
+        Kind kind = Kind::AddVertex;
+        EdgeID edge = 0;
+        VertexIDPair ends{};
+
+        // JoinEdges: the Link that was modified, and what it pointed to before
+        // DeleteVertex: the Vertex that was deleted
+        VertexID vertex = 0;
+        std::size_t whichLink = 0;
+        std::optional<std::pair<VertexID, EdgeID>> previousNext{};
+
+        // DeleteEdge: the Links that were removed from the two end Vertices
+        std::vector<RemovedLink> removedLinks{};
+
+        auto operator<=>(Undo const &other) const = default;
+    };
+
+    /** @brief the state kept while a batch of edits is in progress
+     */
+    struct Batch
+    {
+        std::vector<Undo> journal{};
+
+        // index updates that are deferred until the batch is committed
+        std::vector<std::pair<VertexIDPair, EdgeID>> added{};
+        std::vector<std::pair<VertexIDPair, EdgeID>> removed{};
+
+        auto operator<=>(Batch const &other) const = default;
+    };
+
     auto getCommonVertexID(EdgeID const edge1, EdgeID const edge2,
                            std::map<EdgeID, Edge> const &es) -> MaybeVertexID;
 
@@ -5,7 +5,10 @@
 #include "glm/vec3.hpp"
 #include "glm/mat4x4.hpp"
 
+#include "mycad/Entity.h"
+
 #include <array>
+#include <optional>
 #include <vector>
 
 struct Vertex
@@ -75,6 +78,11 @@ class LineMesh
         auto getIndices() const -> std::vector<uint32_t> const &;
 
     private:
+        friend auto makeLineMesh(mycad::Entity const & entity, unsigned threads)
+            -> std::optional<LineMesh>;
+
+        LineMesh() = default;
+
         // Returns the index to indices of the added vertex - this function will
         // avoid adding duplicate vertices
         std::size_t addVertex(LineVertex const & vertex);
@@ -83,6 +91,18 @@ class LineMesh
         std::vector<uint32_t> indices;
 };
 
+// Builds a LineMesh with one segment per Edge of the Entity, in EdgeID order,
+// or std::nullopt if there aren't any Edges.
+//
+// Each segment gets its own four vertices and six indices (the same quad that
+// addSegment makes), written straight into buffers sized up front, so unlike
+// addSegment there is no search for duplicates. The Edges are split into
+// chunks that are meshed by `threads` threads. Zero means one per hardware
+// thread, but with at least a few thousand Edges each, so that a small Entity
+// (e.g. one meshed every frame) is done on the calling thread.
+auto makeLineMesh(mycad::Entity const & entity, unsigned threads = 0)
+    -> std::optional<LineMesh>;
+
 // alignas added explicitly to remind you in the future in case you have
 // unaligned member variables
 struct MVPBufferObject
@@ -0,0 +1,55 @@
+#include "mycad/BoundingBox.h"
+
+#include <algorithm>
+
+using namespace mycad;
+
+auto BoundingBox::expand(Point const &p) -> void
+{
+    min = {std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z)};
+    max = {std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z)};
+}
+
+auto BoundingBox::expand(BoundingBox const &other) -> void
+{
+    expand(other.min);
+    expand(other.max);
+}
+
+auto BoundingBox::contains(Point const &p) const -> bool
+{
+    return min.x <= p.x && p.x <= max.x &&
+           min.y <= p.y && p.y <= max.y &&
+           min.z <= p.z && p.z <= max.z;
+}
+
+auto BoundingBox::intersects(BoundingBox const &other) const -> bool
+{
+    return min.x <= other.max.x && other.min.x <= max.x &&
+           min.y <= other.max.y && other.min.y <= max.y &&
+           min.z <= other.max.z && other.min.z <= max.z;
+}
+
+auto BoundingBox::center() const -> Point
+{
+    return {(min.x + max.x) / 2, (min.y + max.y) / 2, (min.z + max.z) / 2};
+}
+
+auto mycad::makeBoundingBox(Point const &p1, Point const &p2) -> BoundingBox
+{
+    BoundingBox box{p1, p1};
+    box.expand(p2);
+
+    return box;
+}
+
+auto mycad::makeBoundingBox(Line const &line) -> BoundingBox
+{
+    return makeBoundingBox(line.atU(0), line.atU(1));
+}
+
+auto mycad::operator<<(std::ostream &stream, BoundingBox const &box) -> std::ostream &
+{
+    stream << "BoundingBox: " << box.min << " → " << box.max;
+    return stream;
+}
@@ -0,0 +1,566 @@
+#include "mycad/Bvh.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using namespace mycad;
+
+namespace
+{
+    // Leaves are never split below this size, and never left above the
+    // larger one even if the heuristic says that splitting doesn't pay
+    std::uint32_t constexpr minLeafSize = 2;
+    std::uint32_t constexpr maxLeafSize = 16;
+    std::size_t   constexpr binCount    = 16;
+
+    // Below sahDepth nodes are split at the median rather than by the
+    // heuristic. That halves them each time, so no leaf is deeper than
+    // maxDepth and the queries can walk the tree with a fixed-size stack.
+    std::uint32_t constexpr sahDepth    = 32;
+    std::uint32_t constexpr maxDepth    = sahDepth + 32;
+
+    auto operator-(Point const &a, Point const &b) -> Point
+    {
+        return {a.x - b.x, a.y - b.y, a.z - b.z};
+    }
+
+    auto operator+(Point const &a, Point const &b) -> Point
+    {
+        return {a.x + b.x, a.y + b.y, a.z + b.z};
+    }
+
+    auto operator*(float f, Point const &a) -> Point
+    {
+        return {f * a.x, f * a.y, f * a.z};
+    }
+
+    auto dot(Point const &a, Point const &b) -> float
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    auto component(Point const &p, int axis) -> float
+    {
+        return axis == 0 ? p.x : axis == 1 ? p.y : p.z;
+    }
+
+    /** @brief a box that grows to exactly fit the first Point added to it
+     *
+     *  It must never be passed to BoundingBox::expand itself, as that would
+     *  add its infinite corners to the other box.
+     */
+    auto emptyBox() -> BoundingBox
+    {
+        float const inf = std::numeric_limits<float>::infinity();
+        return {{inf, inf, inf}, {-inf, -inf, -inf}};
+    }
+
+    /** @brief the part of the surface area heuristic that depends on the box
+     *
+     *  Drawings are often flat, so this falls back to the sum of the sides
+     *  if @param flat is set, i.e. if the box being split has no area.
+     */
+    auto cost(BoundingBox const &box, bool flat) -> float
+    {
+        Point const d = box.max - box.min;
+        if (d.x < 0)
+        {
+            return 0; // nothing has been added to the box
+        }
+        return flat ? d.x + d.y + d.z : d.x * d.y + d.y * d.z + d.z * d.x;
+    }
+
+    auto distanceSquared(BoundingBox const &box, Point const &p) -> float
+    {
+        auto outside = [](float lo, float hi, float x)
+        {
+            return std::max({lo - x, 0.0f, x - hi});
+        };
+
+        float const dx = outside(box.min.x, box.max.x, p.x);
+        float const dy = outside(box.min.y, box.max.y, p.y);
+        float const dz = outside(box.min.z, box.max.z, p.z);
+
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    /** @brief the range of distances along a Ray inside a box
+     *
+     *  @param invDirection is one over each component of the Ray's direction.
+     *  @returns false if the Ray misses the box
+     */
+    auto clip(BoundingBox const &box, Ray const &ray, Point const &invDirection,
+              float &tMin, float &tMax) -> bool
+    {
+        tMin = 0;
+        tMax = std::numeric_limits<float>::infinity();
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            float const o  = component(ray.origin, axis);
+            float const lo = component(box.min, axis);
+            float const hi = component(box.max, axis);
+
+            if (component(ray.direction, axis) == 0)
+            {
+                if (o < lo || o > hi)
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            float const inv = component(invDirection, axis);
+            float t1 = (lo - o) * inv;
+            float t2 = (hi - o) * inv;
+            if (t1 > t2)
+            {
+                std::swap(t1, t2);
+            }
+
+            tMin = std::max(tMin, t1);
+            tMax = std::min(tMax, t2);
+            if (tMin > tMax)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /** @brief the closest approach of a Ray with a unit direction to
+     *         @param line
+     *
+     *  This is the segment-segment algorithm from Ericson's "Real-Time
+     *  Collision Detection", with the far end of the Ray left unclamped.
+     *
+     *  @returns the distance along the Ray, and the Point on the Line
+     */
+    auto closestApproach(Ray const &ray, PreparedLine const &line)
+        -> std::pair<float, Point>
+    {
+        Point const p1 = line.atU(0);
+        Point const &d = line.direction();
+        Point const r = ray.origin - p1;
+
+        float const b = dot(ray.direction, d);
+        float const c = dot(ray.direction, r);
+        float const e = line.lengthSquared();
+        float const f = dot(d, r);
+
+        float const denominator = e - b * b;
+        float t = denominator != 0 ? std::max(0.0f, (b * f - c * e) / denominator) : 0;
+        float s = (b * t + f) / e;
+
+        if (s < 0)
+        {
+            s = 0;
+            t = std::max(0.0f, -c);
+        }
+        else if (s > 1)
+        {
+            s = 1;
+            t = std::max(0.0f, b - c);
+        }
+
+        return {t, p1 + s * d};
+    }
+}
+
+Bvh::Bvh(Entity const &entity)
+{
+    EdgeView const edges = entity.edges();
+
+    items.reserve(edges.size());
+    for (auto const [id, line] : edges)
+    {
+        items.push_back({PreparedLine(line), id});
+    }
+
+    build();
+}
+
+auto Bvh::size() const -> std::size_t
+{
+    return items.size();
+}
+
+auto Bvh::empty() const -> bool
+{
+    return items.empty();
+}
+
+/**
+ * The tree is built top-down with an explicit stack, so a lopsided drawing
+ * can't overflow the call stack. Each split buckets the centres of the Items
+ * into binCount bins along the longest axis and picks the boundary between
+ * bins that minimizes the surface area heuristic. Items are partitioned in
+ * place, so every node's Items are contiguous. A lopsided drawing can make the
+ * heuristic peel off a few Items at a time, so deep nodes are split at the
+ * median instead, which bounds the depth of the tree.
+ */
+auto Bvh::build() -> void
+{
+    nodes.clear();
+    if (items.empty())
+    {
+        return;
+    }
+
+    struct Task
+    {
+        std::uint32_t node, first, count, depth;
+    };
+
+    auto center = [](Item const &item)
+    {
+        return item.line.box().center();
+    };
+
+    nodes.reserve(2 * items.size() / minLeafSize);
+    nodes.push_back({});
+
+    std::vector<Task> stack{{0, 0, static_cast<std::uint32_t>(items.size()), 0}};
+    while (not stack.empty())
+    {
+        auto const [index, first, count, depth] = stack.back();
+        stack.pop_back();
+
+        BoundingBox box = emptyBox();
+        BoundingBox centerBox = emptyBox();
+        for (std::uint32_t i = first; i < first + count; i++)
+        {
+            box.expand(items[i].line.box());
+            centerBox.expand(center(items[i]));
+        }
+
+        nodes[index] = {box, first, count};
+        if (count <= minLeafSize)
+        {
+            continue;
+        }
+
+        Point const extent = centerBox.max - centerBox.min;
+        int const axis = extent.x >= extent.y && extent.x >= extent.z ? 0
+                       : extent.y >= extent.z                         ? 1
+                       :                                                2;
+
+        float const lo = component(centerBox.min, axis);
+        float const width = component(extent, axis);
+
+        std::uint32_t split = first + count / 2;
+        if (depth >= sahDepth)
+        {
+            auto const firstItem = items.begin() + first;
+            std::nth_element(firstItem, items.begin() + split, firstItem + count,
+                             [&](Item const &a, Item const &b)
+            {
+                return component(center(a), axis) < component(center(b), axis);
+            });
+        }
+        else if (width > 0)
+        {
+            auto binOf = [&](Item const &item)
+            {
+                float const x = (component(center(item), axis) - lo) / width;
+                return std::min(static_cast<std::size_t>(x * binCount), binCount - 1);
+            };
+
+            std::array<BoundingBox, binCount> bins;
+            std::array<std::uint32_t, binCount> counts{};
+            bins.fill(emptyBox());
+            for (std::uint32_t i = first; i < first + count; i++)
+            {
+                std::size_t const bin = binOf(items[i]);
+                bins[bin].expand(items[i].line.box());
+                counts[bin]++;
+            }
+
+            bool const flat = cost(box, false) == 0;
+
+            // Sweep from the right to get the cost of everything after each
+            // boundary, then from the left to find the cheapest boundary
+            std::array<float, binCount> rightCosts{};
+            BoundingBox right = emptyBox();
+            std::uint32_t rightCount = 0;
+            for (std::size_t b = binCount - 1; b > 0; b--)
+            {
+                if (counts[b] > 0)
+                {
+                    right.expand(bins[b]);
+                }
+                rightCount += counts[b];
+                rightCosts[b] = cost(right, flat) * static_cast<float>(rightCount);
+            }
+
+            float bestCost = std::numeric_limits<float>::infinity();
+            std::size_t bestBin = 0;
+            BoundingBox left = emptyBox();
+            std::uint32_t leftCount = 0;
+            for (std::size_t b = 1; b < binCount; b++)
+            {
+                if (counts[b - 1] > 0)
+                {
+                    left.expand(bins[b - 1]);
+                }
+                leftCount += counts[b - 1];
+                if (leftCount == 0 || leftCount == count)
+                {
+                    continue;
+                }
+
+                float const c = cost(left, flat) * static_cast<float>(leftCount) + rightCosts[b];
+                if (c < bestCost)
+                {
+                    bestCost = c;
+                    bestBin = b;
+                }
+            }
+
+            if (bestCost >= cost(box, flat) * static_cast<float>(count) &&
+                count <= maxLeafSize)
+            {
+                continue;
+            }
+
+            auto const firstItem = items.begin() + first;
+            auto const lastItem = firstItem + count;
+            auto const middle = std::partition(firstItem, lastItem, [&](Item const &item)
+            {
+                return binOf(item) < bestBin;
+            });
+            split = static_cast<std::uint32_t>(middle - items.begin());
+        }
+        else if (count <= maxLeafSize)
+        {
+            continue;
+        }
+
+        auto const left = static_cast<std::uint32_t>(nodes.size());
+        nodes.push_back({});
+        nodes.push_back({});
+        nodes[index].first = left;
+        nodes[index].count = 0;
+
+        stack.push_back({left + 1, split, first + count - split, depth + 1});
+        stack.push_back({left, first, split - first, depth + 1});
+    }
+}
+
+/**
+ * The Entity stores its Lines by EdgeID, so each Item's Line is a direct
+ * lookup. Every Edge is checked before anything is changed.
+ *
+ * Every child is stored after its parent, so walking the nodes backwards
+ * visits both children before the node that contains them.
+ */
+auto Bvh::refit(Entity const &entity) -> bool
+{
+    auto const exists = [&entity](Item const &item){return entity.getLine(item.edge).has_value();};
+    if (not std::ranges::all_of(items, exists))
+    {
+        return false;
+    }
+
+    std::span<Line const> const lines = entity.getLines();
+    for (Item &item : items)
+    {
+        item.line = PreparedLine(lines[static_cast<std::size_t>(item.edge)]);
+    }
+
+    for (auto node = nodes.rbegin(); node != nodes.rend(); node++)
+    {
+        BoundingBox box = emptyBox();
+        if (node->count == 0)
+        {
+            box = nodes[node->first].box;
+            box.expand(nodes[node->first + 1].box);
+        }
+        else
+        {
+            for (std::uint32_t i = node->first; i < node->first + node->count; i++)
+            {
+                box.expand(items[i].line.box());
+            }
+        }
+        node->box = box;
+    }
+
+    return true;
+}
+
+auto Bvh::nearest(Point const &p, float maxDistance) const -> MaybeEdgeHit
+{
+    if (nodes.empty())
+    {
+        return std::nullopt;
+    }
+
+    MaybeEdgeHit best;
+    float bestSquared = maxDistance * maxDistance;
+
+    std::uint32_t stack[maxDepth + 1];
+    std::size_t depth = 0;
+    stack[depth++] = 0;
+
+    while (depth > 0)
+    {
+        Node const &node = nodes[stack[--depth]];
+
+        if (distanceSquared(node.box, p) > bestSquared)
+        {
+            continue;
+        }
+
+        if (node.count == 0)
+        {
+            // Visit the closer child first, so that it can prune the other
+            float const left  = distanceSquared(nodes[node.first].box, p);
+            float const right = distanceSquared(nodes[node.first + 1].box, p);
+            stack[depth++] = left < right ? node.first + 1 : node.first;
+            stack[depth++] = left < right ? node.first : node.first + 1;
+            continue;
+        }
+
+        for (std::uint32_t i = node.first; i < node.first + node.count; i++)
+        {
+            Point const q = items[i].line.closestPoint(p);
+            float const d = dot(q - p, q - p);
+            if (d < bestSquared || (not best.has_value() && d <= bestSquared))
+            {
+                bestSquared = d;
+                best = EdgeHit{items[i].edge, q, 0, 0};
+            }
+        }
+    }
+
+    if (best.has_value())
+    {
+        best->distance = std::sqrt(bestSquared);
+    }
+
+    return best;
+}
+
+auto Bvh::pick(Ray const &ray, float tolerance) const -> MaybeEdgeHit
+{
+    float const length = std::sqrt(dot(ray.direction, ray.direction));
+    if (nodes.empty() || length == 0)
+    {
+        return std::nullopt;
+    }
+
+    Ray const unit{ray.origin, (1 / length) * ray.direction};
+    Point const inv{1 / unit.direction.x, 1 / unit.direction.y, 1 / unit.direction.z};
+    Point const pad{tolerance, tolerance, tolerance};
+
+    // If the Ray comes within tolerance of a Line at some distance along it,
+    // that part of the Ray is inside the Line's box grown by tolerance
+    auto enter = [&](Node const &node, float &tMin)
+    {
+        float tMax = 0;
+        return clip({node.box.min - pad, node.box.max + pad}, unit, inv, tMin, tMax);
+    };
+
+    MaybeEdgeHit best;
+    std::uint32_t stack[maxDepth + 1];
+    std::size_t depth = 0;
+    stack[depth++] = 0;
+
+    while (depth > 0)
+    {
+        Node const &node = nodes[stack[--depth]];
+
+        float tMin = 0;
+        if (not enter(node, tMin) || (best.has_value() && tMin > best->along))
+        {
+            continue;
+        }
+
+        if (node.count == 0)
+        {
+            float left = 0, right = 0;
+            bool const hitLeft  = enter(nodes[node.first], left);
+            bool const hitRight = enter(nodes[node.first + 1], right);
+
+            bool const leftFirst = hitLeft && (not hitRight || left <= right);
+            if (hitLeft && hitRight)
+            {
+                stack[depth++] = leftFirst ? node.first + 1 : node.first;
+            }
+            if (hitLeft || hitRight)
+            {
+                stack[depth++] = leftFirst ? node.first : node.first + 1;
+            }
+            continue;
+        }
+
+        for (std::uint32_t i = node.first; i < node.first + node.count; i++)
+        {
+            auto const [t, q] = closestApproach(unit, items[i].line);
+            Point const onRay = unit.origin + t * unit.direction;
+            float const d = std::sqrt(dot(q - onRay, q - onRay));
+
+            if (d <= tolerance && (not best.has_value() || t < best->along))
+            {
+                best = EdgeHit{items[i].edge, q, d, t};
+            }
+        }
+    }
+
+    return best;
+}
+
+auto Bvh::select(BoundingBox const &box, SelectMode mode) const -> EdgeIDs
+{
+    EdgeIDs out;
+    if (nodes.empty())
+    {
+        return out;
+    }
+
+    auto inside = [&box](BoundingBox const &other)
+    {
+        return box.contains(other.min) && box.contains(other.max);
+    };
+
+    // Once a node is inside the box, so is everything under it
+    std::pair<std::uint32_t, bool> stack[maxDepth + 1];
+    std::size_t depth = 0;
+    stack[depth++] = {0, false};
+
+    while (depth > 0)
+    {
+        auto const [index, contained] = stack[--depth];
+
+        Node const &node = nodes[index];
+        if (not contained && not box.intersects(node.box))
+        {
+            continue;
+        }
+
+        bool const all = contained || inside(node.box);
+        if (node.count == 0)
+        {
+            stack[depth++] = {node.first + 1, all};
+            stack[depth++] = {node.first, all};
+            continue;
+        }
+
+        for (std::uint32_t i = node.first; i < node.first + node.count; i++)
+        {
+            Item const &item = items[i];
+            bool const selected = all ||
+                (mode == SelectMode::Window ? inside(item.line.box())
+                                            : item.line.crosses(box));
+            if (selected)
+            {
+                out.push_back(item.edge);
+            }
+        }
+    }
+
+    return out;
+}
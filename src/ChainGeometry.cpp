@@ -0,0 +1,114 @@
+#include "mycad/ChainGeometry.h"
+
+#include <algorithm>
+
+using namespace mycad;
+
+auto ChainGeometry::size() const -> std::size_t
+{
+    return pieces.size();
+}
+
+auto ChainGeometry::edges() const -> EdgeIDs const &
+{
+    return ids;
+}
+
+auto ChainGeometry::points() const -> std::vector<Point>
+{
+    std::vector<Point> out;
+    out.reserve(pieces.size() + 1);
+    for (Piece const &piece : pieces)
+    {
+        out.push_back(piece.line.atU(piece.reversed ? 1 : 0));
+    }
+    out.push_back(pieces.back().line.atU(pieces.back().reversed ? 0 : 1));
+
+    return out;
+}
+
+auto ChainGeometry::length() const -> float
+{
+    return static_cast<float>(prefix.back());
+}
+
+auto ChainGeometry::lengthBefore(std::size_t i) const -> float
+{
+    return static_cast<float>(prefix.at(i));
+}
+
+auto ChainGeometry::locate(float s) const -> ChainPosition
+{
+    double const clamped = std::clamp(double(s), 0.0, prefix.back());
+    std::size_t const i = find(clamped);
+    float const t = fraction(i, clamped);
+
+    return {pieces[i].edge, pieces[i].reversed ? 1 - t : t};
+}
+
+auto ChainGeometry::atLength(float s) const -> Point
+{
+    double const clamped = std::clamp(double(s), 0.0, prefix.back());
+    return at(find(clamped), clamped);
+}
+
+/**
+ * This is a merge of the (hopefully sorted) distances with the running totals:
+ * the current Piece only ever moves forwards, so a sorted batch of `m`
+ * distances along `n` Pieces costs O(n + m) instead of O(m log n).
+ */
+auto ChainGeometry::atLengths(std::span<float const> ss, std::span<Point> out) const -> bool
+{
+    if (out.size() < ss.size())
+    {
+        return false;
+    }
+
+    std::size_t i = 0;
+    for (std::size_t k = 0; k < ss.size(); k++)
+    {
+        double const s = std::clamp(double(ss[k]), 0.0, prefix.back());
+        if (s < prefix[i])
+        {
+            i = find(s);
+        }
+        else
+        {
+            while (i + 1 < pieces.size() && prefix[i + 1] <= s)
+            {
+                i++;
+            }
+        }
+
+        out[k] = at(i, s);
+    }
+
+    return true;
+}
+
+auto ChainGeometry::find(double s) const -> std::size_t
+{
+    // Only the boundaries between Pieces need searching: anything past the
+    // last one is on the last Piece
+    auto const first = prefix.begin() + 1;
+    auto const last = prefix.end() - 1;
+
+    return static_cast<std::size_t>(std::upper_bound(first, last, s) - first);
+}
+
+auto ChainGeometry::fraction(std::size_t i, double s) const -> float
+{
+    double const length = prefix[i + 1] - prefix[i];
+    if (not (length > 0))
+    {
+        return 0;
+    }
+
+    return static_cast<float>(std::clamp((s - prefix[i]) / length, 0.0, 1.0));
+}
+
+auto ChainGeometry::at(std::size_t i, double s) const -> Point
+{
+    float const t = fraction(i, s);
+    return pieces[i].line.atU(pieces[i].reversed ? 1 - t : t);
+}
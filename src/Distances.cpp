@@ -0,0 +1,259 @@
+#include "mycad/Distances.h"
+#include "detail/Simd.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using namespace mycad;
+namespace simd = mycad::detail::simd;
+
+namespace
+{
+    using simd::Floats;
+
+    struct Vector
+    {
+        Floats x, y, z;
+    };
+
+    auto splat(Point const &p) -> Vector
+    {
+        return {simd::broadcast(p.x), simd::broadcast(p.y), simd::broadcast(p.z)};
+    }
+
+    auto loadPoints(PointArray const &points, std::size_t i) -> Vector
+    {
+        return {simd::load(points.xs().data() + i),
+                simd::load(points.ys().data() + i),
+                simd::load(points.zs().data() + i)};
+    }
+
+    auto operator-(Vector const &a, Vector const &b) -> Vector
+    {
+        using namespace simd;
+        return {a.x - b.x, a.y - b.y, a.z - b.z};
+    }
+
+    auto dot(Vector const &a, Vector const &b) -> Floats
+    {
+        using namespace simd;
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    /** @returns @param a + @param u * @param d */
+    auto along(Vector const &a, Floats u, Vector const &d) -> Vector
+    {
+        using namespace simd;
+        return {a.x + u * d.x, a.y + u * d.y, a.z + u * d.z};
+    }
+
+    auto clamp01(Floats u) -> Floats
+    {
+        return simd::min(simd::max(u, simd::broadcast(0)), simd::broadcast(1));
+    }
+
+    /** @brief a squared length that is safe to divide by
+     *
+     *  The ends of a Line always differ, but the squared length of a very
+     *  short one can still round to zero. Dividing by one instead gives a
+     *  parameter of (about) zero, which is right for what is then a point.
+     */
+    auto divisor(Floats lengthSquared) -> Floats
+    {
+        return simd::select(lengthSquared > simd::broadcast(0), lengthSquared, simd::broadcast(1));
+    }
+
+    /** @brief writes the lanes of @param v to @param out from @param i, but
+     *         no further than @param count
+     */
+    auto put(std::span<float> out, std::size_t i, std::size_t count, Floats v) -> void
+    {
+        if (i + simd::width <= count)
+        {
+            simd::store(out.data() + i, v);
+            return;
+        }
+
+        std::array<float, simd::width> lanes;
+        simd::store(lanes.data(), v);
+        std::copy(lanes.begin(), lanes.begin() + static_cast<std::ptrdiff_t>(count - i),
+                  out.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+
+    auto safe(float lengthSquared) -> float
+    {
+        return lengthSquared > 0 ? lengthSquared : 1;
+    }
+
+    auto dot(Point const &a, Point const &b) -> float
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    auto difference(Point const &a, Point const &b) -> Point
+    {
+        return {a.x - b.x, a.y - b.y, a.z - b.z};
+    }
+}
+
+/**
+ * This is the segment-segment algorithm from Ericson's "Real-Time Collision
+ * Detection". closestApproaches does exactly the same arithmetic a vector at
+ * a time, so the two agree.
+ */
+auto mycad::closestApproach(Line const &a, Line const &b) -> Approach
+{
+    Point const p = a.atU(0);
+    Point const q = b.atU(0);
+    Point const d1 = difference(a.atU(1), p);
+    Point const d2 = difference(b.atU(1), q);
+    Point const r = difference(p, q);
+
+    float const aa = dot(d1, d1);
+    float const ee = dot(d2, d2);
+    float const bb = dot(d1, d2);
+    float const c  = dot(d1, r);
+    float const f  = dot(d2, r);
+
+    float const denominator = aa * ee - bb * bb;
+    float s = denominator > 0 ? std::clamp((bb * f - c * ee) / denominator, 0.0f, 1.0f) : 0;
+    float t = (bb * s + f) / safe(ee);
+
+    if (t < 0)
+    {
+        s = std::clamp(-c / safe(aa), 0.0f, 1.0f);
+    }
+    else if (t > 1)
+    {
+        s = std::clamp((bb - c) / safe(aa), 0.0f, 1.0f);
+    }
+    t = std::clamp(t, 0.0f, 1.0f);
+
+    float const dx = (p.x + s * d1.x) - (q.x + t * d2.x);
+    float const dy = (p.y + s * d1.y) - (q.y + t * d2.y);
+    float const dz = (p.z + s * d1.z) - (q.z + t * d2.z);
+
+    return {s, t, std::sqrt(dx * dx + dy * dy + dz * dz)};
+}
+
+/**
+ * Each of these kernels runs over the padding at the end of a PointArray's
+ * lanes (which is always a whole number of vectors) rather than finishing off
+ * one Point at a time, and only writes back the results for real Points.
+ */
+auto mycad::closestPoints(Line const &line, PointArray const &points,
+                          std::span<float> us, std::span<float> distances) -> bool
+{
+    using namespace simd;
+
+    std::size_t const n = points.size();
+    if (us.size() < n || distances.size() < n)
+    {
+        return false;
+    }
+
+    Point const start = line.atU(0);
+    Point const delta = difference(line.atU(1), start);
+
+    Vector const a = splat(start);
+    Vector const d = splat(delta);
+    Floats const inverse = simd::broadcast(1 / safe(dot(delta, delta)));
+
+    for (std::size_t i = 0; i < n; i += width)
+    {
+        Vector const p = loadPoints(points, i);
+        Floats const u = clamp01(dot(p - a, d) * inverse);
+        Vector const offset = p - along(a, u, d);
+
+        put(us, i, n, u);
+        put(distances, i, n, sqrt(dot(offset, offset)));
+    }
+
+    return true;
+}
+
+auto mycad::closestPoints(PointArray const &starts, PointArray const &ends, Point const &p,
+                          std::span<float> us, std::span<float> distances) -> bool
+{
+    using namespace simd;
+
+    std::size_t const n = starts.size();
+    if (ends.size() != n || us.size() < n || distances.size() < n)
+    {
+        return false;
+    }
+
+    Vector const q = splat(p);
+
+    for (std::size_t i = 0; i < n; i += width)
+    {
+        Vector const a = loadPoints(starts, i);
+        Vector const d = loadPoints(ends, i) - a;
+
+        Floats const u = clamp01(dot(q - a, d) / divisor(dot(d, d)));
+        Vector const offset = q - along(a, u, d);
+
+        put(us, i, n, u);
+        put(distances, i, n, sqrt(dot(offset, offset)));
+    }
+
+    return true;
+}
+
+auto mycad::closestApproaches(Line const &line, PointArray const &starts, PointArray const &ends,
+                              std::span<float> us, std::span<float> vs,
+                              std::span<float> distances) -> bool
+{
+    using namespace simd;
+
+    std::size_t const n = starts.size();
+    if (ends.size() != n || us.size() < n || vs.size() < n || distances.size() < n)
+    {
+        return false;
+    }
+
+    Point const start = line.atU(0);
+    Point const delta = difference(line.atU(1), start);
+
+    Vector const q  = splat(start);
+    Vector const d2 = splat(delta);
+    Floats const ee = simd::broadcast(dot(delta, delta));
+    Floats const eeDivisor = simd::broadcast(safe(dot(delta, delta)));
+
+    Floats const zero = simd::broadcast(0);
+    Floats const one  = simd::broadcast(1);
+
+    for (std::size_t i = 0; i < n; i += width)
+    {
+        Vector const p  = loadPoints(starts, i);
+        Vector const d1 = loadPoints(ends, i) - p;
+        Vector const r  = p - q;
+
+        Floats const aa = dot(d1, d1);
+        Floats const bb = dot(d1, d2);
+        Floats const c  = dot(d1, r);
+        Floats const f  = dot(d2, r);
+
+        // Where the infinite lines are closest, or the start of this Line if
+        // they're parallel
+        Floats const denominator = aa * ee - bb * bb;
+        Floats s = select(denominator > zero, clamp01((bb * f - c * ee) / denominator), zero);
+        Floats t = (bb * s + f) / eeDivisor;
+
+        // If that's off either end of the other Line, clamp it there and
+        // find the closest point on this Line again
+        Floats const aaDivisor = divisor(aa);
+        s = select(t < zero, clamp01((zero - c) / aaDivisor),
+                   select(t > one, clamp01((bb - c) / aaDivisor), s));
+        t = clamp01(t);
+
+        Vector const offset = along(p, s, d1) - along(q, t, d2);
+
+        put(us, i, n, s);
+        put(vs, i, n, t);
+        put(distances, i, n, sqrt(dot(offset, offset)));
+    }
+
+    return true;
+}
@@ -1,48 +1,103 @@
 #include "mycad/Entity.h"
+#include "mycad/SpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
 
 using namespace mycad;
+namespace ranges = std::ranges;
+
+namespace
+{
+    /** @returns true if @param p is on one of the faces of @param box, so
+     *           that moving it away could shrink the box
+     */
+    auto onSurface(BoundingBox const &box, Point const &p) -> bool
+    {
+        return p.x == box.min.x || p.x == box.max.x ||
+               p.y == box.min.y || p.y == box.max.y ||
+               p.z == box.min.z || p.z == box.max.z;
+    }
+}
 
 auto Entity::addVertex(Point const p) -> VertexID
 {
     auto v = topo.addFreeVertex();
-    vertices.emplace(v, p);
+    points.append(p);
+    vertexLive.push_back(1);
+    vertexChanges.add(++current);
+
+    if (box.has_value())
+    {
+        box->expand(p);
+    }
+    else
+    {
+        box = BoundingBox{p, p};
+    }
 
     return v;
 }
 
 auto Entity::addEdge(VertexID const v1, VertexID const v2) -> MaybeEdgeID
 {
-    auto maybeEdge = topo.makeEdge(v1, v2);
-
-    // This also ensures that the topology contains v1 and v2, otherwise the
-    // edge would not have been....er...."makeable"
-    if(not maybeEdge.has_value())
+    if (not (topo.hasVertex(v1) && topo.hasVertex(v2)))
     {
         return std::nullopt;
     }
 
-    auto maybeLine = mycad::makeLine(vertices.at(v1), vertices.at(v2));
+    // Check the geometry first so that we never leave an Edge in the topology
+    // that doesn't have a Line to go with it
+    auto maybeLine = mycad::makeLine(points.at(v1), points.at(v2));
 
     if(not maybeLine.has_value())
     {
         return std::nullopt;
     }
 
-    edges.emplace(*maybeEdge, *maybeLine);
+    auto maybeEdge = topo.makeEdge(v1, v2);
+
+    if(not maybeEdge.has_value())
+    {
+        return std::nullopt;
+    }
+
+    // The Topology numbers Edges in order, so this is always the next slot
+    lines.push_back(*maybeLine);
+    live.push_back(true);
+    liveCount++;
+    edgeChanges.add(++current);
 
     return maybeEdge;
 }
 
+auto Entity::hasVertex(VertexID v) const -> bool
+{
+    return v < vertexLive.size() && vertexLive[v] != 0;
+}
+
+auto Entity::hasEdge(EdgeID e) const -> bool
+{
+    return e >= 0 && static_cast<std::size_t>(e) < lines.size() && live[static_cast<std::size_t>(e)];
+}
+
 auto Entity::getPoint(VertexID const v) const -> Point
 {
-    return vertices.at(v);
+    if (not hasVertex(v))
+    {
+        throw std::out_of_range("No such Vertex");
+    }
+
+    return points.at(v);
 }
 
 auto Entity::getLine(EdgeID const e) const -> MaybeLine
 {
-    if(topo.hasEdge(e))
+    if(hasEdge(e))
     {
-        return edges.at(e);
+        return lineOf(e);
     }
 
     return std::nullopt;
@@ -51,10 +106,960 @@ auto Entity::getLine(EdgeID const e) const -> MaybeLine
 auto Entity::getEdges() const -> Lines
 {
     Lines out;
-    for (auto const & [_, line] : edges)
+    out.reserve(liveCount);
+    for (auto const [_, line] : edges())
     {
         out.push_back(line);
     }
 
     return out;
 }
+
+auto Entity::edges() const -> EdgeView
+{
+    return {lines, live, liveCount};
+}
+
+auto Entity::getLines() const -> std::span<Line const>
+{
+    return lines;
+}
+
+auto Entity::getTopology() const -> Topology const &
+{
+    return topo;
+}
+
+auto Entity::moveVertex(VertexID v, Point const p) -> bool
+{
+    VertexMove const move{v, p};
+    return moveVertices({&move, 1});
+}
+
+/**
+ * Every Point is moved first, so that an Edge between two moved Vertices is
+ * only ever made from their final Points. The new Lines are kept to one side
+ * until all of them have been made, and if any of them can't be the Points
+ * are put back.
+ */
+auto Entity::moveVertices(std::span<VertexMove const> moves) -> bool
+{
+    auto const exists = [this](VertexMove const &m){return hasVertex(m.vertex);};
+    if (not ranges::all_of(moves, exists))
+    {
+        return false;
+    }
+
+    std::vector<VertexMove> from;
+    from.reserve(moves.size());
+    for (VertexMove const &m : moves)
+    {
+        from.push_back({m.vertex, points.at(m.vertex)});
+        points.set(m.vertex, m.point);
+    }
+
+    std::vector<std::pair<EdgeID, Line>> remade;
+    for (VertexMove const &m : moves)
+    {
+        for (detail::Link const &link : topo.linksAt(m.vertex))
+        {
+            auto const line = lineBetweenEnds(link.parentEdge);
+            if (not line.has_value())
+            {
+                for (auto undo = from.rbegin(); undo != from.rend(); undo++)
+                {
+                    points.set(undo->vertex, undo->point);
+                }
+                return false;
+            }
+
+            remade.emplace_back(link.parentEdge, *line);
+        }
+    }
+
+    current++;
+    for (VertexMove const &m : moves)
+    {
+        vertexChanges.touch(m.vertex, current);
+    }
+    for (auto const &[e, line] : remade)
+    {
+        replaceLine(e, line);
+    }
+
+    for (std::size_t i = 0; i < moves.size(); i++)
+    {
+        if (box.has_value())
+        {
+            boxStale = boxStale || onSurface(*box, from[i].point);
+            box->expand(moves[i].point);
+        }
+    }
+
+    if (batchStart.has_value())
+    {
+        batchMoves.insert(batchMoves.end(), from.begin(), from.end());
+    }
+
+    return true;
+}
+
+/**
+ * The Points are put in a PointGrid with cells the size of the tolerance.
+ * Going through the Vertices in order, each one that hasn't been merged yet is
+ * kept, and takes every other Vertex within the tolerance of it out of the
+ * grid. Every Vertex is taken out once and each query only looks at the cells
+ * around it, so this is close to linear unless the Points are very bunched up.
+ *
+ * Merging is not transitive: a Vertex joins the first kept Vertex within the
+ * tolerance of it, even if it's within the tolerance of a Vertex that merged
+ * into some other one.
+ *
+ * Then every Edge with a merged end is deleted and, unless both of its ends
+ * went to the same place, made again between the kept Vertices.
+ */
+auto Entity::weld(float tolerance) -> WeldResult
+{
+    if (not (tolerance > 0))
+    {
+        tolerance = 0;
+    }
+
+    WeldResult out;
+    out.vertices.resize(points.size());
+    std::iota(out.vertices.begin(), out.vertices.end(), VertexID{0});
+
+    PointGrid grid(tolerance > 0 ? tolerance : 1.0f);
+    grid.reserve(points.size());
+    for (VertexID v = 0; v < points.size(); v++)
+    {
+        if (hasVertex(v))
+        {
+            grid.insert(v, points.at(v));
+        }
+    }
+
+    std::vector<VertexID> merged;
+    for (VertexID v = 0; v < points.size(); v++)
+    {
+        if (not grid.contains(v))
+        {
+            continue;
+        }
+
+        for (Neighbour const &n : grid.withinRadius(points.at(v), tolerance))
+        {
+            grid.remove(n.id);
+            if (n.id != v)
+            {
+                out.vertices[n.id] = v;
+                merged.push_back(n.id);
+            }
+        }
+    }
+
+    if (merged.empty())
+    {
+        return out;
+    }
+
+    EdgeIDs rewire;
+    for (auto const [e, _] : edges())
+    {
+        auto const [v1, v2] = topo.getEdgeVertices(e).value();
+        if (out.vertices[v1] != v1 || out.vertices[v2] != v2)
+        {
+            rewire.push_back(e);
+        }
+    }
+
+    for (EdgeID const e : rewire)
+    {
+        auto const [v1, v2] = topo.getEdgeVertices(e).value();
+        dropEdge(e);
+
+        VertexID const to1 = out.vertices[v1];
+        VertexID const to2 = out.vertices[v2];
+        out.edges.emplace_back(e, to1 == to2 ? std::nullopt : addEdge(to1, to2));
+    }
+
+    return out;
+}
+
+auto Entity::removeEdge(EdgeID e) -> bool
+{
+    if (not hasEdge(e))
+    {
+        return false;
+    }
+
+    dropEdge(e);
+
+    return true;
+}
+
+/**
+ * The Point stays where it is, so that the VertexIDs after it still line up,
+ * but it no longer counts towards the bounds.
+ */
+auto Entity::removeVertex(VertexID v) -> bool
+{
+    if (not hasVertex(v))
+    {
+        return false;
+    }
+
+    // dropEdge changes the Links, so work from a copy
+    EdgeIDs adjacent;
+    for (detail::Link const &link : topo.linksAt(v))
+    {
+        adjacent.push_back(link.parentEdge);
+    }
+    for (EdgeID const e : adjacent)
+    {
+        if (hasEdge(e))
+        {
+            dropEdge(e);
+        }
+    }
+
+    topo.deleteVertex(v);
+    vertexLive[v] = 0;
+    deadVertices++;
+
+    current++;
+    vertexChanges.touch(v, current);
+    if (box.has_value())
+    {
+        boxStale = boxStale || onSurface(*box, points.at(v));
+    }
+
+    if (batchStart.has_value())
+    {
+        batchRemoved.push_back(v);
+    }
+
+    return true;
+}
+
+/**
+ * New IDs are never greater than old ones, so the Points and Lines can be moved
+ * down into their new slots in place, in ID order.
+ */
+auto Entity::compact() -> std::optional<IDRemap>
+{
+    auto remap = topo.compact();
+    if (not remap.has_value())
+    {
+        return std::nullopt;
+    }
+
+    std::size_t keptVertices = 0;
+    for (VertexID v = 0; v < remap->vertices.size(); v++)
+    {
+        if (auto const to = remap->vertices[v])
+        {
+            points.set(*to, points.at(v));
+            keptVertices++;
+        }
+    }
+    points.resize(keptVertices);
+    vertexLive.assign(keptVertices, 1);
+    deadVertices = 0;
+
+    std::size_t keptEdges = 0;
+    for (std::size_t e = 0; e < remap->edges.size(); e++)
+    {
+        if (auto const to = remap->edges[e])
+        {
+            lines[static_cast<std::size_t>(*to)] = lines[e];
+            keptEdges++;
+        }
+    }
+    lines.erase(lines.begin() + static_cast<std::ptrdiff_t>(keptEdges), lines.end());
+    live.assign(keptEdges, true);
+    liveCount = keptEdges;
+
+    current++;
+    vertexChanges = {};
+    edgeChanges = {};
+    for (std::size_t i = 0; i < keptVertices; i++)
+    {
+        vertexChanges.add(current);
+    }
+    for (std::size_t i = 0; i < keptEdges; i++)
+    {
+        edgeChanges.add(current);
+    }
+
+    // Links keep their positions, so only the Vertex in each key moves
+    std::map<ChainKey, MaybeBoundingBox> moved;
+    for (auto const &[key, chainBox] : chainBoxes)
+    {
+        if (auto const to = remap->vertices[key.first])
+        {
+            moved.emplace(ChainKey{*to, key.second}, chainBox);
+        }
+    }
+    chainBoxes = std::move(moved);
+    reindexChains();
+
+    return remap;
+}
+
+auto Entity::generation() const -> Generation
+{
+    return current;
+}
+
+auto Entity::changesSince(Generation since) const -> EntityChanges
+{
+    EntityChanges out{current, vertexChanges.since(since), {}, points.size(), lines.size()};
+
+    auto const edgeIDs = edgeChanges.since(since);
+    out.edges.reserve(edgeIDs.size());
+    for (std::size_t const e : edgeIDs)
+    {
+        out.edges.push_back(static_cast<EdgeID>(e));
+    }
+
+    return out;
+}
+
+auto Entity::bounds() const -> MaybeBoundingBox
+{
+    if (boxStale)
+    {
+        box = liveBounds();
+        boxStale = false;
+    }
+
+    return box;
+}
+
+auto Entity::getEdgeBounds(EdgeID e) const -> MaybeBoundingBox
+{
+    if (not hasEdge(e))
+    {
+        return std::nullopt;
+    }
+
+    return makeBoundingBox(lineOf(e));
+}
+
+/**
+ * Every Chain made through joinEdges has a box, which is walked again here if
+ * a move has made it stale. Any other Chain the Topology recognises, such as
+ * one that starts part way along a joined Chain, is walked every time.
+ */
+auto Entity::getChainBounds(Chain c) const -> MaybeBoundingBox
+{
+    auto const found = chainBoxes.find({c.whichVertex, c.whichLink});
+    if (found == chainBoxes.end())
+    {
+        return walkChainBounds(c);
+    }
+
+    if (not found->second.has_value())
+    {
+        found->second = walkChainBounds(c);
+    }
+
+    return found->second;
+}
+
+auto Entity::joinEdges(EdgeID fromEdge, EdgeID toEdge) -> MaybeChain
+{
+    auto const chain = topo.joinEdges(fromEdge, toEdge);
+    if (chain.has_value())
+    {
+        // toEdge may already lead on to more Edges, and Chains that ended at
+        // fromEdge now lead on to all of them too
+        growChains(fromEdge);
+        trackChain(*chain);
+    }
+
+    return chain;
+}
+
+auto Entity::extendChain(Chain c, EdgeID nextEdge) -> bool
+{
+    if (not topo.extendChain(c, nextEdge))
+    {
+        return false;
+    }
+
+    // The Edge that nextEdge now follows is one whose Link points at it. The
+    // Chains we keep a box for through that Edge may or may not have been
+    // extended, depending on which way they pass through it, and
+    // growChains walks them to find out.
+    auto const [v1, v2] = topo.getEdgeVertices(nextEdge).value();
+    for (VertexID const v : {v1, v2})
+    {
+        for (detail::Link const &link : topo.linksAt(v))
+        {
+            if (link.parentEdge != nextEdge && link.next.has_value() &&
+                link.next->second == nextEdge)
+            {
+                growChains(link.parentEdge);
+            }
+        }
+    }
+
+    // Otherwise, e.g. for a Chain that starts part way along one of ours or
+    // whose key moved, walk it once and keep its box from now on
+    trackChain(c);
+
+    return true;
+}
+
+/**
+ * A Chain's Vertex is the one its first Edge shares with the second, so the
+ * walk starts from the other end of the first Edge. From there, each Edge is
+ * walked backwards if its Line starts where the walk has got to.
+ */
+auto Entity::getChainGeometry(Chain c) const -> MaybeChainGeometry
+{
+    auto const maybeEdges = topo.getChainEdges(c);
+    if (not maybeEdges.has_value() || maybeEdges->empty())
+    {
+        return std::nullopt;
+    }
+
+    EdgeIDs const &chainEdges = *maybeEdges;
+
+    ChainGeometry out;
+    out.ids = chainEdges;
+    out.pieces.reserve(chainEdges.size());
+    out.prefix.reserve(chainEdges.size() + 1);
+    out.prefix.push_back(0);
+
+    VertexID at = topo.oppositeVertex(c.whichVertex, chainEdges.front()).value();
+    for (EdgeID const e : chainEdges)
+    {
+        auto const [v1, v2] = topo.getEdgeVertices(e).value();
+        Line const &line = lineOf(e);
+
+        bool const reversed = at != v1;
+        at = reversed ? v1 : v2;
+
+        out.pieces.push_back({e, line, reversed});
+        out.prefix.push_back(out.prefix.back() + line.length());
+    }
+
+    return out;
+}
+
+auto Entity::shortestPath(VertexID from, VertexID to,
+                          TraversalScratch &scratch) const -> MaybeEdgeIDs
+{
+    auto lineLength = [this](EdgeID e){return lineOf(e).length();};
+
+    return weightedShortestPath(topo, from, to, scratch, lineLength);
+}
+
+/**
+ * This is the usual half-edge walk. Each Edge `e` from `a` to `b` becomes two
+ * half-edges, `2i` (a → b) and `2i + 1` (b → a), where `i` numbers the Edges in
+ * order. Half-edge `h ^ 1` is therefore always the twin of `h`.
+ *
+ * The half-edges leaving each Vertex are sorted by angle. Arriving at Vertex `v`
+ * along `h`, the walk continues along the half-edge leaving `v` immediately
+ * clockwise of `twin(h)`, which keeps the Face on the left-hand side. Sorting
+ * is the only super-linear step.
+ */
+auto Entity::findFaces() const -> Faces
+{
+    struct HalfEdge
+    {
+        VertexID from, to;
+        EdgeID edge;
+    };
+
+    std::vector<HalfEdge> halfEdges;
+    halfEdges.reserve(2 * liveCount);
+
+    for (auto const [e, _] : edges())
+    {
+        auto const [from, to] = topo.getEdgeVertices(e).value();
+        if (from == to)
+        {
+            continue;
+        }
+
+        halfEdges.push_back({from, to, e});
+        halfEdges.push_back({to, from, e});
+    }
+
+    // Bucket the outgoing half-edges by Vertex (counting sort), then order
+    // each bucket counter-clockwise
+    std::size_t const nVertices = topo.vertexCount();
+    std::vector<std::size_t> offsets(nVertices + 1, 0);
+    for (auto const &h : halfEdges)
+    {
+        offsets.at(h.from + 1)++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<float> angles(halfEdges.size());
+    std::vector<std::size_t> outgoing(halfEdges.size());
+    std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+
+    for (std::size_t h = 0; h < halfEdges.size(); h++)
+    {
+        Point const from = points.at(halfEdges.at(h).from);
+        Point const to   = points.at(halfEdges.at(h).to);
+
+        angles.at(h) = std::atan2(to.y - from.y, to.x - from.x);
+        outgoing.at(fill.at(halfEdges.at(h).from)++) = h;
+    }
+
+    // where each half-edge ended up in its Vertex's bucket
+    std::vector<std::size_t> slot(halfEdges.size());
+    for (std::size_t v = 0; v < nVertices; v++)
+    {
+        auto const first = outgoing.begin() + offsets.at(v);
+        auto const last  = outgoing.begin() + offsets.at(v + 1);
+
+        ranges::sort(first, last,
+                    [&angles](auto a, auto b){return angles.at(a) < angles.at(b);});
+
+        for (std::size_t i = offsets.at(v); i < offsets.at(v + 1); i++)
+        {
+            slot.at(outgoing.at(i)) = i;
+        }
+    }
+
+    auto next = [&](std::size_t h)
+    {
+        std::size_t const twin = h ^ 1;
+        VertexID const v = halfEdges.at(h).to;
+        std::size_t const i = slot.at(twin);
+
+        // one step clockwise, wrapping around the bucket
+        return outgoing.at(i == offsets.at(v) ? offsets.at(v + 1) - 1 : i - 1);
+    };
+
+    Faces out{};
+    std::vector<bool> walked(halfEdges.size(), false);
+
+    for (std::size_t start = 0; start < halfEdges.size(); start++)
+    {
+        if (walked.at(start))
+        {
+            continue;
+        }
+
+        Face face{{}, 0};
+        Point const origin = points.at(halfEdges.at(start).from);
+
+        for (std::size_t h = start; not walked.at(h); h = next(h))
+        {
+            walked.at(h) = true;
+            face.edges.push_back(halfEdges.at(h).edge);
+
+            // shoelace formula, relative to the origin to limit round-off
+            Point const a = points.at(halfEdges.at(h).from);
+            Point const b = points.at(halfEdges.at(h).to);
+            face.area += ((a.x - origin.x) * (b.y - origin.y) -
+                          (b.x - origin.x) * (a.y - origin.y)) / 2;
+        }
+
+        out.push_back(std::move(face));
+    }
+
+    return out;
+}
+
+auto Entity::beginBatch() -> bool
+{
+    if (not topo.beginBatch())
+    {
+        return false;
+    }
+
+    batchStart = {points.size(), static_cast<EdgeID>(lines.size())};
+    batchMoves.clear();
+    batchDeleted.clear();
+    batchRemoved.clear();
+
+    return true;
+}
+
+auto Entity::commit() -> bool
+{
+    batchStart.reset();
+    batchMoves.clear();
+    batchDeleted.clear();
+    batchRemoved.clear();
+    return topo.commit();
+}
+
+/**
+ * IDs are handed out in increasing order, so everything that was added during
+ * the batch sits at the end of the storage. Moves are undone in reverse, and
+ * once the Topology is back to how it was the Lines around each of those
+ * Vertices are made again.
+ */
+auto Entity::rollback() -> bool
+{
+    if (not topo.rollback())
+    {
+        return false;
+    }
+
+    auto const [firstVertex, firstEdge] = batchStart.value();
+    points.resize(firstVertex);
+    lines.erase(lines.begin() + firstEdge, lines.end());
+    live.resize(static_cast<std::size_t>(firstEdge));
+    vertexChanges.truncate(firstVertex);
+    edgeChanges.truncate(static_cast<std::size_t>(firstEdge));
+    batchStart.reset();
+
+    // Anything put back has changed again, as far as anyone who looked at it
+    // during the batch is concerned
+    current++;
+
+    for (EdgeID const e : batchDeleted)
+    {
+        if (e < firstEdge)
+        {
+            live[static_cast<std::size_t>(e)] = true;
+            edgeChanges.touch(static_cast<std::size_t>(e), current);
+        }
+    }
+    batchDeleted.clear();
+    liveCount = static_cast<std::size_t>(ranges::count(live, true));
+
+    vertexLive.resize(firstVertex);
+    for (VertexID const v : batchRemoved)
+    {
+        if (v < firstVertex)
+        {
+            vertexLive[v] = 1;
+            vertexChanges.touch(v, current);
+        }
+    }
+    batchRemoved.clear();
+    deadVertices = static_cast<std::size_t>(ranges::count(vertexLive, 0.0f));
+
+    for (auto undo = batchMoves.rbegin(); undo != batchMoves.rend(); undo++)
+    {
+        if (undo->vertex < firstVertex)
+        {
+            points.set(undo->vertex, undo->point);
+        }
+    }
+
+    for (VertexMove const &undo : batchMoves)
+    {
+        if (undo.vertex < firstVertex)
+        {
+            vertexChanges.touch(undo.vertex, current);
+            for (detail::Link const &link : topo.linksAt(undo.vertex))
+            {
+                replaceLine(link.parentEdge, lineBetweenEnds(link.parentEdge).value());
+            }
+        }
+    }
+    batchMoves.clear();
+
+    recomputeBounds();
+
+    return true;
+}
+
+auto Entity::recomputeBounds() -> void
+{
+    box = liveBounds();
+    boxStale = false;
+
+    reindexChains();
+}
+
+/**
+ * Either way this is a SIMD reduction over the Points. Once a Vertex has been
+ * removed, vertexLive is used as a mask to blend the dead Points away.
+ */
+auto Entity::liveBounds() const -> MaybeBoundingBox
+{
+    if (deadVertices == 0)
+    {
+        return points.bounds();
+    }
+
+    return points.bounds(vertexLive);
+}
+
+/**
+ * Chains that no longer exist are dropped, and the rest are walked again since
+ * they may have been extended or moved.
+ */
+auto Entity::reindexChains() -> void
+{
+    chainsByEdge.clear();
+
+    for (auto it = chainBoxes.begin(); it != chainBoxes.end();)
+    {
+        auto const chainEdges = topo.getChainEdges({it->first.first, it->first.second});
+        if (not chainEdges.has_value() || chainEdges->empty())
+        {
+            it = chainBoxes.erase(it);
+            continue;
+        }
+
+        BoundingBox chainBox = makeBoundingBox(lineOf(chainEdges->front()));
+        for (EdgeID const e : *chainEdges)
+        {
+            chainBox.expand(makeBoundingBox(lineOf(e)));
+            indexChain(it->first, e);
+        }
+
+        it->second = chainBox;
+        ++it;
+    }
+}
+
+auto Entity::dropEdge(EdgeID e) -> void
+{
+    auto const [v1, v2] = topo.getEdgeVertices(e).value();
+    rekeyChains(v1, e);
+    if (v2 != v1)
+    {
+        rekeyChains(v2, e);
+    }
+
+    topo.deleteEdge(e);
+
+    live[static_cast<std::size_t>(e)] = false;
+    liveCount--;
+
+    current++;
+    edgeChanges.touch(static_cast<std::size_t>(e), current);
+
+    // Any Chain through the Edge is broken, so its box is left to be walked
+    // again (and found to be gone)
+    auto const [first, last] = chainsByEdge.equal_range(e);
+    for (auto it = first; it != last; it++)
+    {
+        resetChainBox(it->second);
+    }
+    chainsByEdge.erase(first, last);
+
+    if (batchStart.has_value())
+    {
+        batchDeleted.push_back(e);
+    }
+}
+
+/**
+ * A Chain is keyed by a position in its Vertex's Links, and deleting the Edge
+ * takes its Links out of the middle of them. Chains keyed after those move
+ * down to match, and any that start on the Edge itself are broken and dropped.
+ *
+ * Keys only ever move down, and no further than the first removed Link, so
+ * going through them in order never renames one onto another still to come.
+ */
+auto Entity::rekeyChains(VertexID v, EdgeID e) -> void
+{
+    std::vector<std::size_t> removed;
+    auto const links = topo.linksAt(v);
+    for (std::size_t i = 0; i < links.size(); i++)
+    {
+        if (links[i].parentEdge == e)
+        {
+            removed.push_back(i);
+        }
+    }
+
+    std::vector<std::pair<ChainKey, MaybeBoundingBox>> moved;
+    auto it = chainBoxes.lower_bound({v, 0});
+    while (it != chainBoxes.end() && it->first.first == v)
+    {
+        ChainKey const from = it->first;
+        if (ranges::find(removed, from.second) != removed.end())
+        {
+            unindexChain(from);
+            it = chainBoxes.erase(it);
+            continue;
+        }
+
+        auto const shift = static_cast<std::size_t>(
+            ranges::count_if(removed, [&](std::size_t r){return r < from.second;}));
+        if (shift == 0)
+        {
+            it++;
+            continue;
+        }
+
+        ChainKey const to{v, from.second - shift};
+        for (EdgeID const chainEdge : topo.getChainEdges({from.first, from.second}).value_or(EdgeIDs{}))
+        {
+            auto const [first, last] = chainsByEdge.equal_range(chainEdge);
+            for (auto entry = first; entry != last; entry++)
+            {
+                if (entry->second == from)
+                {
+                    entry->second = to;
+                }
+            }
+        }
+
+        moved.emplace_back(to, it->second);
+        it = chainBoxes.erase(it);
+    }
+
+    chainBoxes.insert(moved.begin(), moved.end());
+}
+
+auto Entity::indexChain(ChainKey key, EdgeID e) -> void
+{
+    chainsByEdge.emplace(e, key);
+}
+
+auto Entity::trackChain(Chain c) -> void
+{
+    ChainKey const key{c.whichVertex, c.whichLink};
+    if (chainBoxes.contains(key))
+    {
+        return;
+    }
+
+    auto const chainEdges = topo.getChainEdges(c);
+    if (not chainEdges.has_value() || chainEdges->empty())
+    {
+        return;
+    }
+
+    BoundingBox chainBox = makeBoundingBox(lineOf(chainEdges->front()));
+    for (EdgeID const e : *chainEdges)
+    {
+        chainBox.expand(makeBoundingBox(lineOf(e)));
+        indexChain(key, e);
+    }
+    chainBoxes.emplace(key, chainBox);
+}
+
+/**
+ * Joining only ever adds Edges to the end of a Chain, so each Chain through
+ * @param e is walked and any Edge it isn't indexed on yet is new. A Chain that
+ * passes through @param e the other way, and so wasn't extended, finds none.
+ */
+auto Entity::growChains(EdgeID e) -> void
+{
+    std::vector<ChainKey> through;
+    auto const [first, last] = chainsByEdge.equal_range(e);
+    for (auto it = first; it != last; it++)
+    {
+        through.push_back(it->second);
+    }
+
+    for (ChainKey const &key : through)
+    {
+        auto const found = chainBoxes.find(key);
+        auto const chainEdges = topo.getChainEdges({key.first, key.second});
+        if (found == chainBoxes.end() || not chainEdges.has_value())
+        {
+            continue;
+        }
+
+        for (EdgeID const chainEdge : *chainEdges)
+        {
+            if (isIndexed(key, chainEdge))
+            {
+                continue;
+            }
+
+            if (found->second.has_value())
+            {
+                found->second->expand(makeBoundingBox(lineOf(chainEdge)));
+            }
+            indexChain(key, chainEdge);
+        }
+    }
+}
+
+/**
+ * A Chain that has already been broken can't be walked by unindexChain, so
+ * some of its Edges may still point at a key that has since been dropped.
+ */
+auto Entity::resetChainBox(ChainKey key) -> void
+{
+    auto const found = chainBoxes.find(key);
+    if (found != chainBoxes.end())
+    {
+        found->second.reset();
+    }
+}
+
+auto Entity::isIndexed(ChainKey key, EdgeID e) const -> bool
+{
+    auto const [first, last] = chainsByEdge.equal_range(e);
+    return std::any_of(first, last, [&key](auto const &entry){return entry.second == key;});
+}
+
+/**
+ * The Chain is walked to find its Edges, so this is O(n) for n Edges rather
+ * than a scan of every indexed Edge.
+ */
+auto Entity::unindexChain(ChainKey key) -> void
+{
+    auto const chainEdges = topo.getChainEdges({key.first, key.second});
+    if (not chainEdges.has_value())
+    {
+        return;
+    }
+
+    for (EdgeID const e : *chainEdges)
+    {
+        auto const [first, last] = chainsByEdge.equal_range(e);
+        for (auto it = first; it != last;)
+        {
+            it = it->second == key ? chainsByEdge.erase(it) : std::next(it);
+        }
+    }
+}
+
+auto Entity::lineBetweenEnds(EdgeID e) const -> MaybeLine
+{
+    auto const [v1, v2] = topo.getEdgeVertices(e).value();
+    return makeLine(points.at(v1), points.at(v2));
+}
+
+/**
+ * Any Chain the Edge is part of may have shrunk, so its box is left to be
+ * walked again.
+ */
+auto Entity::replaceLine(EdgeID e, Line const &line) -> void
+{
+    lines[static_cast<std::size_t>(e)] = line;
+    edgeChanges.touch(static_cast<std::size_t>(e), current);
+
+    auto const [first, last] = chainsByEdge.equal_range(e);
+    for (auto it = first; it != last; it++)
+    {
+        resetChainBox(it->second);
+    }
+}
+
+auto Entity::lineOf(EdgeID e) const -> Line const &
+{
+    return lines[static_cast<std::size_t>(e)];
+}
+
+auto Entity::walkChainBounds(Chain c) const -> MaybeBoundingBox
+{
+    auto const chainEdges = topo.getChainEdges(c);
+    if (not chainEdges.has_value() || chainEdges->empty())
+    {
+        return std::nullopt;
+    }
+
+    BoundingBox chainBox = makeBoundingBox(lineOf(chainEdges->front()));
+    for (EdgeID const e : *chainEdges)
+    {
+        chainBox.expand(makeBoundingBox(lineOf(e)));
+    }
+
+    return chainBox;
+}
@@ -1,72 +1,317 @@
 #include "mycad/Geometry.h"
+#include "mycad/Predicates.h"
+#include "detail/Simd.h"
 
-#include <cmath> // std::lerp (since c++20)
+#include <array>
+#include <cmath>
 #include <iostream>
+#include <numbers>
+#include <type_traits>
 
 using namespace mycad;
+namespace simd = mycad::detail::simd;
 
-auto mycad::makeLine(Point const &p1, Point const &p2) -> MaybeLine
+namespace
 {
-    if (p1 == p2)
+    float constexpr fullTurn = 2 * std::numbers::pi_v<float>;
+
+    /** @brief std::lerp, for a whole vector of @param t at once
+     *
+     *  @param a and @param b are the same for every lane, so the choice between
+     *  the two formulas std::lerp uses only has to be made once.
+     */
+    auto lerp(float a, float b, simd::Floats t) -> simd::Floats
     {
-        return std::nullopt;
+        using namespace simd;
+
+        Floats const one = broadcast(1);
+        Floats const vb  = broadcast(b);
+
+        if ((a <= 0 && b >= 0) || (a >= 0 && b <= 0))
+        {
+            return t * vb + (one - t) * broadcast(a);
+        }
+
+        Floats const x = broadcast(a) + t * broadcast(b - a);
+
+        // (t > 1) == (b > a) ? max(x, b) : min(x, b)
+        Mask const beyond = t > one;
+        Floats const monotonic = (b > a) ? select(beyond, max(x, vb), min(x, vb))
+                                         : select(beyond, min(x, vb), max(x, vb));
+
+        return select(t == one, vb, monotonic);
     }
-    else
+
+    /** @brief Line::atU for simd::width parameters, written to @param out
+     */
+    auto sample(Point const &p1, Point const &p2, simd::Floats u, Point *out) -> void
     {
-        return {Line(p1, p2)};
+        using namespace simd;
+
+        Floats const zero = broadcast(0);
+        Floats const one  = broadcast(1);
+
+        auto component = [&](float a, float b)
+        {
+            return select(u == zero, broadcast(a),
+                          select(u == one, broadcast(b), lerp(a, b, u)));
+        };
+
+        std::array<float, width> xs, ys, zs;
+        store(xs.data(), component(p1.x, p2.x));
+        store(ys.data(), component(p1.y, p2.y));
+        store(zs.data(), component(p1.z, p2.z));
+
+        for (std::size_t i = 0; i < width; i++)
+        {
+            out[i] = {xs[i], ys[i], zs[i]};
+        }
     }
 }
 
-Line::Line(Point const &p1, Point const &p2)
-    : p1(p1), p2(p2){}
+template <typename T>
+auto BasicLine<T>::sampleU(std::span<T const> us, std::span<Point> out) const -> bool
+{
+    if (out.size() < us.size())
+    {
+        return false;
+    }
 
-Point Line::atU(float u) const
+    std::size_t i = 0;
+    if constexpr (std::is_same_v<T, float>)
+    {
+        for (; i + simd::width <= us.size(); i += simd::width)
+        {
+            sample(p1, p2, simd::load(us.data() + i), out.data() + i);
+        }
+    }
+
+    for (; i < us.size(); i++)
+    {
+        out[i] = atU(us[i]);
+    }
+
+    return true;
+}
+
+/**
+ * Each u is computed as `i / (n - 1)` rather than by accumulating a step, so
+ * that the last one is exactly 1 and no error builds up along the way.
+ */
+template <typename T>
+auto BasicLine<T>::sampleUniform(std::span<Point> out) const -> void
 {
-    if (u == 0)
+    std::size_t const n = out.size();
+    if (n < 2)
     {
-        return p1;
+        if (n == 1)
+        {
+            out[0] = p1;
+        }
+        return;
     }
-    else if (u == 1)
+
+    std::size_t i = 0;
+    if constexpr (std::is_same_v<T, float>)
     {
-        return p2;
+        std::array<float, simd::width> lanes;
+        for (std::size_t lane = 0; lane < simd::width; lane++)
+        {
+            lanes[lane] = static_cast<float>(lane);
+        }
+
+        simd::Floats const offsets = simd::load(lanes.data());
+        simd::Floats const last = simd::broadcast(static_cast<float>(n - 1));
+
+        for (; i + simd::width <= n; i += simd::width)
+        {
+            simd::Floats const index = simd::broadcast(static_cast<float>(i)) + offsets;
+            sample(p1, p2, index / last, out.data() + i);
+        }
     }
 
-    return Point(std::lerp(p1.x, p2.x, u),
-                 std::lerp(p1.y, p2.y, u),
-                 std::lerp(p1.z, p2.z, u)
-            );
+    for (; i < n; i++)
+    {
+        out[i] = atU(static_cast<T>(i) / static_cast<T>(n - 1));
+    }
 }
 
-auto Line::intersects(Point const &p) const -> bool
+template <typename T>
+auto BasicLine<T>::intersects(Point const &p) const -> bool
 {
     if (p == p1 || p == p2)
     {
         return true;
     }
 
-    // The parametric equations of a 3d line are:
+    if constexpr (std::is_same_v<T, float>)
+    {
+        if (collinear(p1, p2, p))
+        {
+            return true;
+        }
+    }
+    else
+    {
+        T const ax = p2.x - p1.x, ay = p2.y - p1.y, az = p2.z - p1.z;
+        T const bx = p.x - p1.x,  by = p.y - p1.y,  bz = p.z - p1.z;
+
+        if (ay * bz == az * by && az * bx == ax * bz && ax * by == ay * bx)
+        {
+            return true;
+        }
+    }
+
+    // Points computed with atU are rounded, so are rarely exactly collinear.
+    // Instead we see if we can get them back again. The parametric equations
+    // of a 3d line are:
     //
     // x = x₁ + (x₂ - x₁)u
     // y = y₁ + (y₂ - y₁)u
     // z = z₁ + (z₂ - z₁)u
     //
     // We can use this to solve for `u` given any one of the components of the
-    // point we were given
-    float u = (p.x - p1.x) / (p2.x - p1.x);
+    // point we were given, as long as the line isn't constant in it
+    auto roundTrips = [&](T a, T b, T x)
+    {
+        return a != b && p == this->atU((x - a) / (b - a));
+    };
+
+    return roundTrips(p1.x, p2.x, p.x) ||
+           roundTrips(p1.y, p2.y, p.y) ||
+           roundTrips(p1.z, p2.z, p.z);
+}
 
-    // Now we should be able to get the point back if it intersects with our
-    // line
-    return p == this->atU(u);
+template <typename T>
+auto BasicLine<T>::length() const -> T
+{
+    return std::hypot(p2.x - p1.x, p2.y - p1.y, p2.z - p1.z);
 }
 
-auto mycad::operator<<(std::ostream &stream, Point const &p) -> std::ostream &
+auto mycad::makeArc(Point const &center, float radius, float startAngle, float sweep)
+    -> MaybeArc
+{
+    if (not (radius > 0 && std::isfinite(radius) && std::isfinite(startAngle) &&
+             sweep != 0 && std::abs(sweep) <= fullTurn))
+    {
+        return std::nullopt;
+    }
+
+    return {Arc(center, radius, startAngle, sweep)};
+}
+
+Arc::Arc(Point const &center, float radius, float startAngle, float sweep)
+    : middle(center), r(radius), start(startAngle), turn(sweep){}
+
+auto Arc::atU(float u) const -> Point
+{
+    float const angle = start + u * turn;
+    return {middle.x + r * std::cos(angle), middle.y + r * std::sin(angle), middle.z};
+}
+
+auto Arc::length() const -> float
+{
+    return r * std::abs(turn);
+}
+
+auto Arc::center() const -> Point const &
+{
+    return middle;
+}
+
+auto Arc::radius() const -> float
+{
+    return r;
+}
+
+auto Arc::startAngle() const -> float
+{
+    return start;
+}
+
+auto Arc::sweep() const -> float
+{
+    return turn;
+}
+
+auto Arc::closed() const -> bool
+{
+    return std::abs(turn) == fullTurn;
+}
+
+auto mycad::makeCircle(Point const &center, float radius) -> MaybeCircle
+{
+    if (not (radius > 0 && std::isfinite(radius)))
+    {
+        return std::nullopt;
+    }
+
+    return {Circle(center, radius)};
+}
+
+Circle::Circle(Point const &center, float radius)
+    : middle(center), r(radius){}
+
+auto Circle::atU(float u) const -> Point
+{
+    return asArc().atU(u);
+}
+
+auto Circle::length() const -> float
+{
+    return r * fullTurn;
+}
+
+auto Circle::center() const -> Point const &
+{
+    return middle;
+}
+
+auto Circle::radius() const -> float
+{
+    return r;
+}
+
+auto Circle::asArc() const -> Arc
+{
+    return makeArc(middle, r, 0, fullTurn).value();
+}
+
+template <typename T>
+auto mycad::operator<<(std::ostream &stream, BasicPoint<T> const &p) -> std::ostream &
 {
     stream << "(" << p.x << ", " << p.y << ", " << p.z << ")";
     return stream;
 }
 
-auto mycad::operator<<(std::ostream &stream, Line const &line) -> std::ostream &
+template <typename T>
+auto mycad::operator<<(std::ostream &stream, BasicLine<T> const &line) -> std::ostream &
 {
     stream << "Line: " << line.atU(0) << " → " << line.atU(1);
     return stream;
 }
+
+auto mycad::operator<<(std::ostream &stream, Arc const &arc) -> std::ostream &
+{
+    stream << "Arc: " << arc.atU(0) << " ↻ " << arc.atU(1) << " about " << arc.center();
+    return stream;
+}
+
+auto mycad::operator<<(std::ostream &stream, Circle const &circle) -> std::ostream &
+{
+    stream << "Circle: " << circle.center() << " r " << circle.radius();
+    return stream;
+}
+
+template struct mycad::BasicPoint<float>;
+template struct mycad::BasicPoint<double>;
+template class mycad::BasicLine<float>;
+template class mycad::BasicLine<double>;
+
+template auto mycad::makeLine<float>(Point const &p1, Point const &p2) -> MaybeLine;
+template auto mycad::makeLine<double>(PointD const &p1, PointD const &p2) -> MaybeLineD;
+
+template auto mycad::operator<<(std::ostream &stream, Point const &p) -> std::ostream &;
+template auto mycad::operator<<(std::ostream &stream, PointD const &p) -> std::ostream &;
+template auto mycad::operator<<(std::ostream &stream, Line const &line) -> std::ostream &;
+template auto mycad::operator<<(std::ostream &stream, LineD const &line) -> std::ostream &;
@@ -0,0 +1,345 @@
+#include "mycad/Intersections.h"
+#include "mycad/Predicates.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace mycad;
+
+namespace
+{
+    struct Segment
+    {
+        Point a, b;
+        EdgeID edge;
+        VertexID v1, v2;
+
+        float minX, minY, maxX, maxY;
+    };
+
+    /** @brief the Lines, bucketed into a uniform grid over the XY plane
+     *
+     *  Each Segment is listed in every cell its box touches. The lists are
+     *  stored back to back, with the start of each cell's list in `starts`.
+     */
+    struct Grid
+    {
+        float x0, y0, cellSize;
+        std::size_t nx, ny;
+
+        std::vector<std::size_t> starts;
+        std::vector<std::uint32_t> items;
+
+        auto column(float x) const -> std::size_t
+        {
+            auto const c = static_cast<std::ptrdiff_t>(std::floor((x - x0) / cellSize));
+            return static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(c, 0, static_cast<std::ptrdiff_t>(nx) - 1));
+        }
+
+        auto row(float y) const -> std::size_t
+        {
+            auto const c = static_cast<std::ptrdiff_t>(std::floor((y - y0) / cellSize));
+            return static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(c, 0, static_cast<std::ptrdiff_t>(ny) - 1));
+        }
+    };
+
+    auto cross(Point const &o, Point const &a, Point const &b) -> double
+    {
+        return (double(a.x) - o.x) * (double(b.y) - o.y) -
+               (double(a.y) - o.y) * (double(b.x) - o.x);
+    }
+
+    auto cross(Point const &a1, Point const &a2, Point const &b1, Point const &b2) -> double
+    {
+        return (double(a2.x) - a1.x) * (double(b2.y) - b1.y) -
+               (double(a2.y) - a1.y) * (double(b2.x) - b1.x);
+    }
+
+    /** @returns the parameter of @param p along @param s, which it's known
+     *           to be collinear with
+     */
+    auto along(Segment const &s, Point const &p) -> double
+    {
+        double const dx = double(s.b.x) - s.a.x;
+        double const dy = double(s.b.y) - s.a.y;
+
+        return ((double(p.x) - s.a.x) * dx + (double(p.y) - s.a.y) * dy) / (dx * dx + dy * dy);
+    }
+
+    /** @brief the Vertex of @param s at @param u, if @param u is one of its
+     *         ends
+     */
+    auto vertexAt(Segment const &s, double u) -> std::optional<VertexID>
+    {
+        return u == 0 ? std::optional(s.v1) : u == 1 ? std::optional(s.v2) : std::nullopt;
+    }
+
+    auto sharedVertex(Segment const &s, double u, Segment const &t, double v) -> bool
+    {
+        auto const a = vertexAt(s, u);
+        return a.has_value() && a == vertexAt(t, v);
+    }
+
+    auto record(Intersections &out, Segment const &s, double u,
+                Segment const &t, double v, bool overlapping) -> void
+    {
+        auto const su = static_cast<float>(std::clamp(u, 0.0, 1.0));
+        auto const tv = static_cast<float>(std::clamp(v, 0.0, 1.0));
+
+        out.push_back(s.edge < t.edge ? Intersection{s.edge, t.edge, su, tv, overlapping}
+                                      : Intersection{t.edge, s.edge, tv, su, overlapping});
+    }
+
+    /** @brief the exact part: decides whether @param s and @param t meet
+     *
+     *  Whether they meet only depends on the signs of four orientations,
+     *  which orient2d gets exactly right. Where one of them is zero an end
+     *  lies on the other Line, so its parameter is known exactly too.
+     */
+    auto intersect(Segment const &s, Segment const &t, Intersections &out) -> void
+    {
+        Orientation const o1 = orient2d(s.a, s.b, t.a);
+        Orientation const o2 = orient2d(s.a, s.b, t.b);
+
+        if (o1 == Orientation::Zero && o2 == Orientation::Zero)
+        {
+            // Collinear, so they overlap wherever their parameters along s do
+            double const ta = along(s, t.a);
+            double const tb = along(s, t.b);
+            double const lo = std::min(ta, tb);
+            double const hi = std::max(ta, tb);
+
+            if (hi < 0 || lo > 1)
+            {
+                return;
+            }
+
+            auto const first = lo <= 0 ? std::pair{0.0, along(t, s.a)}
+                                       : std::pair{lo, lo == ta ? 0.0 : 1.0};
+            auto const last  = hi >= 1 ? std::pair{1.0, along(t, s.b)}
+                                       : std::pair{hi, hi == ta ? 0.0 : 1.0};
+
+            if (first.first < last.first)
+            {
+                record(out, s, first.first, t, first.second, true);
+                record(out, s, last.first, t, last.second, true);
+            }
+            else if (not sharedVertex(s, first.first, t, first.second))
+            {
+                record(out, s, first.first, t, first.second, false);
+            }
+            return;
+        }
+
+        Orientation const o3 = orient2d(t.a, t.b, s.a);
+        Orientation const o4 = orient2d(t.a, t.b, s.b);
+
+        if ((o1 != Orientation::Zero && o1 == o2) || (o3 != Orientation::Zero && o3 == o4))
+        {
+            return;
+        }
+
+        double const denominator = cross(s.a, s.b, t.a, t.b);
+        double u = cross(s.a, t.a, t.b) / denominator;
+        double v = cross(s.a, t.a, s.b) / denominator;
+
+        u = o3 == Orientation::Zero ? 0 : o4 == Orientation::Zero ? 1 : u;
+        v = o1 == Orientation::Zero ? 0 : o2 == Orientation::Zero ? 1 : v;
+
+        if (not sharedVertex(s, u, t, v))
+        {
+            record(out, s, u, t, v, false);
+        }
+    }
+
+    /** @brief sizes the cells so that there are about as many as Segments,
+     *         but no smaller than a typical Segment
+     */
+    auto makeGrid(std::vector<Segment> const &segments) -> Grid
+    {
+        float x0 = segments.front().minX, y0 = segments.front().minY;
+        float x1 = segments.front().maxX, y1 = segments.front().maxY;
+        double extents = 0;
+        for (Segment const &s : segments)
+        {
+            x0 = std::min(x0, s.minX); y0 = std::min(y0, s.minY);
+            x1 = std::max(x1, s.maxX); y1 = std::max(y1, s.maxY);
+            extents += std::max(s.maxX - s.minX, s.maxY - s.minY);
+        }
+
+        double const n = static_cast<double>(segments.size());
+        double const width = std::max(double(x1) - x0, 0.0);
+        double const height = std::max(double(y1) - y0, 0.0);
+
+        double cellSize = std::max(extents / n, std::sqrt(width * height / n));
+        cellSize = std::max({cellSize, width / n, height / n});
+        if (not (cellSize > 0))
+        {
+            cellSize = 1;
+        }
+
+        Grid grid{x0, y0, static_cast<float>(cellSize),
+                  static_cast<std::size_t>(width / cellSize) + 1,
+                  static_cast<std::size_t>(height / cellSize) + 1, {}, {}};
+
+        // Count, then fill, each cell's list
+        grid.starts.assign(grid.nx * grid.ny + 1, 0);
+        for (Segment const &s : segments)
+        {
+            for (std::size_t y = grid.row(s.minY); y <= grid.row(s.maxY); y++)
+            {
+                for (std::size_t x = grid.column(s.minX); x <= grid.column(s.maxX); x++)
+                {
+                    grid.starts[y * grid.nx + x + 1]++;
+                }
+            }
+        }
+        for (std::size_t c = 1; c < grid.starts.size(); c++)
+        {
+            grid.starts[c] += grid.starts[c - 1];
+        }
+
+        std::vector<std::size_t> fill(grid.starts.begin(), grid.starts.end() - 1);
+        grid.items.resize(grid.starts.back());
+        for (std::uint32_t i = 0; i < segments.size(); i++)
+        {
+            Segment const &s = segments[i];
+            for (std::size_t y = grid.row(s.minY); y <= grid.row(s.maxY); y++)
+            {
+                for (std::size_t x = grid.column(s.minX); x <= grid.column(s.maxX); x++)
+                {
+                    grid.items[fill[y * grid.nx + x]++] = i;
+                }
+            }
+        }
+
+        return grid;
+    }
+
+    /** @brief tests every pair of Segments that share one of the cells in
+     *         [@param first, @param last)
+     *
+     *  A pair whose boxes overlap in several cells is only tested in the one
+     *  holding the lower corner of the overlap, so it's never found twice.
+     */
+    auto findInCells(std::vector<Segment> const &segments, Grid const &grid,
+                     std::size_t first, std::size_t last, Intersections &out) -> void
+    {
+        for (std::size_t cell = first; cell < last; cell++)
+        {
+            std::size_t const x = cell % grid.nx;
+            std::size_t const y = cell / grid.nx;
+
+            for (std::size_t i = grid.starts[cell]; i < grid.starts[cell + 1]; i++)
+            {
+                Segment const &s = segments[grid.items[i]];
+                for (std::size_t j = i + 1; j < grid.starts[cell + 1]; j++)
+                {
+                    Segment const &t = segments[grid.items[j]];
+                    if (s.maxX < t.minX || t.maxX < s.minX || s.maxY < t.minY || t.maxY < s.minY)
+                    {
+                        continue;
+                    }
+
+                    if (grid.column(std::max(s.minX, t.minX)) != x ||
+                        grid.row(std::max(s.minY, t.minY)) != y)
+                    {
+                        continue;
+                    }
+
+                    intersect(s, t, out);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * The cells are shared between the threads in contiguous runs of roughly equal
+ * work, counting the number of pairs in each cell. Each thread collects its own
+ * results, which are merged and sorted at the end.
+ */
+auto mycad::findIntersections(Entity const &entity, unsigned threads) -> Intersections
+{
+    Topology const &topo = entity.getTopology();
+    EdgeView const edges = entity.edges();
+
+    std::vector<Segment> segments;
+    segments.reserve(edges.size());
+    for (auto const [id, line] : edges)
+    {
+        Point const a = line.atU(0);
+        Point const b = line.atU(1);
+        if (a.x == b.x && a.y == b.y)
+        {
+            continue; // a single point in the XY plane
+        }
+
+        auto const [v1, v2] = topo.getEdgeVertices(id).value();
+        segments.push_back({a, b, id, v1, v2,
+                            std::min(a.x, b.x), std::min(a.y, b.y),
+                            std::max(a.x, b.x), std::max(a.y, b.y)});
+    }
+
+    Intersections out;
+    if (segments.size() < 2)
+    {
+        return out;
+    }
+
+    Grid const grid = makeGrid(segments);
+    std::size_t const cells = grid.nx * grid.ny;
+
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    if (threads == 1)
+    {
+        findInCells(segments, grid, 0, cells, out);
+    }
+    else
+    {
+        double total = 0;
+        for (std::size_t c = 0; c < cells; c++)
+        {
+            auto const k = static_cast<double>(grid.starts[c + 1] - grid.starts[c]);
+            total += k * k;
+        }
+
+        std::vector<std::size_t> bounds{0};
+        double work = 0;
+        for (std::size_t c = 0; c < cells && bounds.size() < threads; c++)
+        {
+            auto const k = static_cast<double>(grid.starts[c + 1] - grid.starts[c]);
+            work += k * k;
+            if (work >= total * static_cast<double>(bounds.size()) / threads)
+            {
+                bounds.push_back(c + 1);
+            }
+        }
+        bounds.push_back(cells);
+
+        std::vector<Intersections> results(bounds.size() - 1);
+        std::vector<std::thread> workers;
+        for (std::size_t w = 0; w + 1 < bounds.size(); w++)
+        {
+            workers.emplace_back(findInCells, std::cref(segments), std::cref(grid),
+                                 bounds[w], bounds[w + 1], std::ref(results[w]));
+        }
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        for (Intersections const &result : results)
+        {
+            out.insert(out.end(), result.begin(), result.end());
+        }
+    }
+
+    std::ranges::sort(out);
+    return out;
+}
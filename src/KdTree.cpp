@@ -0,0 +1,370 @@
+#include "mycad/SpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using namespace mycad;
+
+namespace
+{
+    // Ranges this small are searched linearly rather than split any further
+    std::size_t constexpr leafSize = 8;
+
+    auto squaredDistance(Point const &a, Point const &b) -> float
+    {
+        float const dx = a.x - b.x;
+        float const dy = a.y - b.y;
+        float const dz = a.z - b.z;
+
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    auto component(Point const &p, std::uint8_t axis) -> float
+    {
+        return axis == 0 ? p.x : axis == 1 ? p.y : p.z;
+    }
+}
+
+KdTree::KdTree(std::span<Point const> points)
+{
+    for (std::size_t i = 0; i < points.size(); i++)
+    {
+        pending.push_back({points[i], i});
+    }
+    states.assign(points.size(), State::Pending);
+    slots.assign(points.size(), 0);
+
+    rebuild();
+}
+
+auto KdTree::size() const -> std::size_t
+{
+    return points.size() - deadCount + pending.size();
+}
+
+auto KdTree::contains(std::size_t id) const -> bool
+{
+    return id < states.size() && states[id] != State::Absent;
+}
+
+/**
+ * Pending Points cost every query a little, so the tree is re-built once
+ * there are more than an eighth as many of them as there are in the tree.
+ * That keeps inserting O(log n) amortized.
+ */
+auto KdTree::insert(std::size_t id, Point const &p) -> bool
+{
+    if (contains(id))
+    {
+        return false;
+    }
+
+    if (id >= states.size())
+    {
+        states.resize(id + 1, State::Absent);
+        slots.resize(id + 1, 0);
+    }
+
+    states[id] = State::Pending;
+    slots[id] = pending.size();
+    pending.push_back({p, id});
+
+    if (pending.size() > std::max<std::size_t>(leafSize, points.size() / 8))
+    {
+        rebuild();
+    }
+
+    return true;
+}
+
+auto KdTree::remove(std::size_t id) -> bool
+{
+    if (not contains(id))
+    {
+        return false;
+    }
+
+    if (states[id] == State::Pending)
+    {
+        std::size_t const slot = slots[id];
+        pending[slot] = pending.back();
+        slots[pending[slot].id] = slot;
+        pending.pop_back();
+    }
+    else
+    {
+        dead[slots[id]] = true;
+        deadCount++;
+    }
+    states[id] = State::Absent;
+
+    if (deadCount > points.size() / 4)
+    {
+        rebuild();
+    }
+
+    return true;
+}
+
+auto KdTree::nearest(Point const &p, float maxDistance) const -> MaybeNeighbour
+{
+    MaybeNeighbour best;
+    float bound = maxDistance * maxDistance;
+
+    auto consider = [&](std::size_t id, float d)
+    {
+        if (d < bound || (not best.has_value() && d <= bound))
+        {
+            bound = d;
+            best = Neighbour{id, 0};
+        }
+    };
+
+    search(p, bound, [&](std::size_t slot, float d){consider(ids[slot], d);});
+    for (auto const &[q, id] : pending)
+    {
+        consider(id, squaredDistance(p, q));
+    }
+
+    if (best.has_value())
+    {
+        best->distance = std::sqrt(bound);
+    }
+
+    return best;
+}
+
+/**
+ * The k best so far are kept in a max-heap, so the furthest of them is always
+ * on top and is the one to beat.
+ */
+auto KdTree::kNearest(Point const &p, std::size_t k) const -> Neighbours
+{
+    Neighbours heap;
+    if (k == 0)
+    {
+        return heap;
+    }
+    heap.reserve(k + 1);
+
+    float bound = std::numeric_limits<float>::infinity();
+
+    auto consider = [&](std::size_t id, float d)
+    {
+        if (heap.size() == k && d >= bound)
+        {
+            return;
+        }
+
+        heap.push_back({id, d});
+        std::ranges::push_heap(heap, {}, &Neighbour::distance);
+        if (heap.size() > k)
+        {
+            std::ranges::pop_heap(heap, {}, &Neighbour::distance);
+            heap.pop_back();
+        }
+        if (heap.size() == k)
+        {
+            bound = heap.front().distance;
+        }
+    };
+
+    search(p, bound, [&](std::size_t slot, float d){consider(ids[slot], d);});
+    for (auto const &[q, id] : pending)
+    {
+        consider(id, squaredDistance(p, q));
+    }
+
+    std::ranges::sort_heap(heap, {}, &Neighbour::distance);
+    for (Neighbour &n : heap)
+    {
+        n.distance = std::sqrt(n.distance);
+    }
+
+    return heap;
+}
+
+auto KdTree::withinRadius(Point const &p, float radius) const -> Neighbours
+{
+    Neighbours out;
+    float const bound = radius * radius;
+
+    search(p, bound, [&](std::size_t slot, float d)
+    {
+        if (d <= bound)
+        {
+            out.push_back({ids[slot], std::sqrt(d)});
+        }
+    });
+
+    for (auto const &[q, id] : pending)
+    {
+        float const d = squaredDistance(p, q);
+        if (d <= bound)
+        {
+            out.push_back({id, std::sqrt(d)});
+        }
+    }
+
+    return out;
+}
+
+auto KdTree::nearest(std::span<Point const> queries,
+                     std::span<MaybeNeighbour> out,
+                     float maxDistance) const -> bool
+{
+    if (out.size() < queries.size())
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < queries.size(); i++)
+    {
+        out[i] = nearest(queries[i], maxDistance);
+    }
+
+    return true;
+}
+
+/**
+ * Each range is split on its widest axis at the median, which std::nth_element
+ * finds (and moves into place) in linear time. The median's slot remembers the
+ * axis, and the halves either side of it become the two subtrees.
+ */
+auto KdTree::build(std::vector<Entry> &entries, std::size_t first, std::size_t last)
+    -> void
+{
+    if (last - first <= leafSize)
+    {
+        return;
+    }
+
+    Point lo = entries[first].p;
+    Point hi = lo;
+    for (std::size_t i = first + 1; i < last; i++)
+    {
+        Point const &p = entries[i].p;
+        lo = {std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z)};
+        hi = {std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z)};
+    }
+
+    float const dx = hi.x - lo.x;
+    float const dy = hi.y - lo.y;
+    float const dz = hi.z - lo.z;
+    std::uint8_t const axis = dx >= dy && dx >= dz ? 0 : dy >= dz ? 1 : 2;
+
+    auto const begin = entries.begin();
+    std::size_t const middle = first + (last - first) / 2;
+    std::nth_element(begin + static_cast<std::ptrdiff_t>(first),
+                     begin + static_cast<std::ptrdiff_t>(middle),
+                     begin + static_cast<std::ptrdiff_t>(last),
+                     [axis](Entry const &a, Entry const &b)
+                     {
+                         return component(a.p, axis) < component(b.p, axis);
+                     });
+
+    axes[middle] = axis;
+    build(entries, first, middle);
+    build(entries, middle + 1, last);
+}
+
+/**
+ * The Points and ids are built into a tree together, and only split into
+ * separate arrays (which is all the queries need) at the end.
+ */
+auto KdTree::rebuild() -> void
+{
+    std::vector<Entry> entries;
+    entries.reserve(size());
+
+    for (std::size_t slot = 0; slot < points.size(); slot++)
+    {
+        if (not dead[slot])
+        {
+            entries.push_back({points[slot], ids[slot]});
+        }
+    }
+    entries.insert(entries.end(), pending.begin(), pending.end());
+
+    axes.assign(entries.size(), 0);
+    dead.assign(entries.size(), false);
+    deadCount = 0;
+    pending.clear();
+
+    build(entries, 0, entries.size());
+
+    points.resize(entries.size());
+    ids.resize(entries.size());
+    for (std::size_t slot = 0; slot < entries.size(); slot++)
+    {
+        points[slot] = entries[slot].p;
+        ids[slot] = entries[slot].id;
+
+        states[ids[slot]] = State::InTree;
+        slots[ids[slot]] = slot;
+    }
+}
+
+/**
+ * A depth-first walk that goes down the side of each split containing @param p
+ * first, and only crosses to the other side if the split is closer than
+ * @param bound.
+ */
+template <typename Visit>
+auto KdTree::search(Point const &p, float const &bound, Visit &&visit) const -> void
+{
+    struct Range
+    {
+        std::size_t first, last;
+
+        // How far the range is from p, squared, as far as is known
+        float gap;
+    };
+
+    Range stack[64];
+    std::size_t depth = 0;
+    stack[depth++] = {0, points.size(), 0};
+
+    while (depth > 0)
+    {
+        auto const [first, last, gap] = stack[--depth];
+        if (gap > bound)
+        {
+            continue;
+        }
+
+        if (last - first <= leafSize)
+        {
+            for (std::size_t slot = first; slot < last; slot++)
+            {
+                if (not dead[slot])
+                {
+                    visit(slot, squaredDistance(p, points[slot]));
+                }
+            }
+            continue;
+        }
+
+        std::size_t const middle = first + (last - first) / 2;
+        std::uint8_t const axis = axes[middle];
+        float const offset = component(p, axis) - component(points[middle], axis);
+
+        if (not dead[middle])
+        {
+            visit(middle, squaredDistance(p, points[middle]));
+        }
+
+        // The far side is pushed first so that the near side is searched
+        // first, by which time bound may have shrunk enough to skip it
+        Range const near = offset < 0 ? Range{first, middle, gap} : Range{middle + 1, last, gap};
+        Range const far  = offset < 0 ? Range{middle + 1, last, 0} : Range{first, middle, 0};
+
+        float const farGap = std::max(gap, offset * offset);
+        if (farGap <= bound)
+        {
+            stack[depth++] = {far.first, far.last, farGap};
+        }
+        stack[depth++] = near;
+    }
+}
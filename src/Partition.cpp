@@ -0,0 +1,174 @@
+#include "mycad/Partition.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility> // std::pair
+
+using namespace mycad;
+namespace ranges = std::ranges;
+
+namespace
+{
+    std::size_t const unassigned = std::numeric_limits<std::size_t>::max();
+
+    // How far over the ideal load a part may grow during refinement, in percent
+    std::size_t const maxImbalance = 5;
+
+    std::size_t const refinementPasses = 3;
+}
+
+/**
+ * Load is measured in Links, i.e. the degree of each Vertex, which adds up to
+ * twice the number of Edges.
+ *
+ * Parts are grown by a single breadth-first sweep: once the current part has
+ * its share of the load, the Vertices still waiting in the queue simply become
+ * the start of the next part. Each part therefore borders the previous one
+ * along a BFS level, which keeps the cut small on mesh-like Topologies.
+ */
+auto mycad::partition(Topology const &topo, std::size_t nParts) -> MaybePartition
+{
+    if (nParts == 0)
+    {
+        return std::nullopt;
+    }
+
+    std::size_t const nVertices = topo.vertexCount();
+
+    auto degree = [&topo](VertexID v){return topo.linksAt(v).size();};
+
+    std::size_t totalLoad = 0;
+    for (VertexID v = 0; v < nVertices; v++)
+    {
+        totalLoad += degree(v);
+    }
+
+    std::vector<std::size_t> parts(nVertices, unassigned);
+    std::vector<std::size_t> loads(nParts, 0);
+
+    std::vector<VertexID> queue;
+    queue.reserve(nVertices);
+
+    std::size_t part = 0;
+    std::size_t assignedLoad = 0;
+    VertexID nextSeed = 0;
+
+    for (std::size_t head = 0; ; head++)
+    {
+        if (head == queue.size())
+        {
+            // start on the next disconnected piece of the Topology
+            while (nextSeed < nVertices && parts.at(nextSeed) != unassigned)
+            {
+                nextSeed++;
+            }
+            if (nextSeed == nVertices)
+            {
+                break;
+            }
+            queue.push_back(nextSeed);
+        }
+
+        VertexID const v = queue.at(head);
+        if (parts.at(v) != unassigned)
+        {
+            continue;
+        }
+
+        parts.at(v) = part;
+        loads.at(part) += degree(v);
+        assignedLoad += degree(v);
+
+        for (auto const &link : topo.linksAt(v))
+        {
+            VertexID const opp = *topo.oppositeVertex(v, link.parentEdge);
+            if (parts.at(opp) == unassigned)
+            {
+                queue.push_back(opp);
+            }
+        }
+
+        // compare against the cumulative target so that rounding doesn't
+        // leave the last part with all the left-overs
+        if (part + 1 < nParts && assignedLoad * nParts >= totalLoad * (part + 1))
+        {
+            part++;
+        }
+    }
+
+    // Refinement: move a boundary Vertex to the neighbouring part it shares
+    // the most Edges with, if that reduces the cut and keeps the balance
+    std::size_t const maxLoad =
+        (totalLoad * (100 + maxImbalance)) / (100 * nParts) + 1;
+    std::vector<std::pair<std::size_t, std::size_t>> neighbourParts;
+
+    for (std::size_t pass = 0; pass < refinementPasses; pass++)
+    {
+        bool moved = false;
+
+        for (VertexID v = 0; v < nVertices; v++)
+        {
+            neighbourParts.clear();
+            for (auto const &link : topo.linksAt(v))
+            {
+                std::size_t const p = parts.at(*topo.oppositeVertex(v, link.parentEdge));
+                auto it = ranges::find(neighbourParts, p, &std::pair<std::size_t, std::size_t>::first);
+                if (it == neighbourParts.end())
+                {
+                    neighbourParts.emplace_back(p, 1);
+                }
+                else
+                {
+                    it->second++;
+                }
+            }
+
+            std::size_t const current = parts.at(v);
+            std::size_t stay = 0;
+            for (auto const &[p, count] : neighbourParts)
+            {
+                stay = (p == current) ? count : stay;
+            }
+
+            auto best = std::pair(current, stay);
+            for (auto const &[p, count] : neighbourParts)
+            {
+                if (count > best.second && loads.at(p) + degree(v) <= maxLoad)
+                {
+                    best = {p, count};
+                }
+            }
+
+            if (best.first != current)
+            {
+                loads.at(current) -= degree(v);
+                loads.at(best.first) += degree(v);
+                parts.at(v) = best.first;
+                moved = true;
+            }
+        }
+
+        if (not moved)
+        {
+            break;
+        }
+    }
+
+    Partition out{parts, {}, std::vector<EdgeIDs>(nParts), {}};
+
+    for (EdgeID const e : topo.edgeIDs())
+    {
+        auto const [left, right] = *topo.getEdgeVertices(e);
+        std::size_t const p = parts.at(left);
+
+        out.edgeParts.emplace_hint(out.edgeParts.end(), e, p);
+        out.partEdges.at(p).push_back(e);
+
+        if (p != parts.at(right))
+        {
+            out.boundaryEdges.push_back(e);
+        }
+    }
+
+    return out;
+}
@@ -0,0 +1,359 @@
+#include "mycad/PointArray.h"
+#include "detail/Simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace mycad;
+namespace simd = mycad::detail::simd;
+
+namespace
+{
+    // Lanes are padded to a whole cache line, which is a whole number of SIMD
+    // vectors for every simd::width
+    std::size_t constexpr padding = 64 / sizeof(float);
+
+    auto padded(std::size_t n) -> std::size_t
+    {
+        return (n + padding - 1) / padding * padding;
+    }
+}
+
+PointArray::PointArray(std::span<Point const> points)
+{
+    resizeLanes(points.size());
+    count = points.size();
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        set(i, points[i]);
+    }
+}
+
+auto PointArray::operator==(PointArray const &other) const -> bool
+{
+    return count == other.count &&
+           std::equal(x.begin(), x.begin() + count, other.x.begin()) &&
+           std::equal(y.begin(), y.begin() + count, other.y.begin()) &&
+           std::equal(z.begin(), z.begin() + count, other.z.begin());
+}
+
+auto PointArray::size() const -> std::size_t
+{
+    return count;
+}
+
+auto PointArray::empty() const -> bool
+{
+    return count == 0;
+}
+
+auto PointArray::reserve(std::size_t n) -> void
+{
+    x.reserve(padded(n));
+    y.reserve(padded(n));
+    z.reserve(padded(n));
+}
+
+auto PointArray::clear() -> void
+{
+    count = 0;
+    resizeLanes(0);
+}
+
+auto PointArray::append(Point const &p) -> void
+{
+    if (count == x.size())
+    {
+        resizeLanes(count + 1);
+    }
+
+    set(count++, p);
+}
+
+auto PointArray::resize(std::size_t n) -> void
+{
+    // The padding is always zeroed, the same as it is after append
+    for (Lane *lane : {&x, &y, &z})
+    {
+        std::fill(lane->begin() + static_cast<std::ptrdiff_t>(std::min(n, count)), lane->end(), 0.0f);
+    }
+
+    resizeLanes(n);
+    count = n;
+}
+
+auto PointArray::at(std::size_t i) const -> Point
+{
+    // The lanes are padded past count, so their own checks aren't enough
+    if (i >= count)
+    {
+        throw std::out_of_range("PointArray::at");
+    }
+
+    return {x[i], y[i], z[i]};
+}
+
+auto PointArray::set(std::size_t i, Point const &p) -> void
+{
+    if (i >= count)
+    {
+        throw std::out_of_range("PointArray::set");
+    }
+
+    x[i] = p.x;
+    y[i] = p.y;
+    z[i] = p.z;
+}
+
+auto PointArray::xs() const -> std::span<float const>
+{
+    return {x.data(), count};
+}
+
+auto PointArray::ys() const -> std::span<float const>
+{
+    return {y.data(), count};
+}
+
+auto PointArray::zs() const -> std::span<float const>
+{
+    return {z.data(), count};
+}
+
+/**
+ * The padding is transformed along with everything else: it's never read back,
+ * and it saves handling a partial vector at the end.
+ */
+auto PointArray::transform(Matrix4 const &m) -> void
+{
+    using namespace simd;
+
+    std::array<Floats, 12> rows;
+    for (std::size_t i = 0; i < rows.size(); i++)
+    {
+        rows[i] = broadcast(m[i]);
+    }
+
+    for (std::size_t i = 0; i < x.size(); i += width)
+    {
+        Floats const px = load(x.data() + i);
+        Floats const py = load(y.data() + i);
+        Floats const pz = load(z.data() + i);
+
+        store(x.data() + i, rows[0] * px + rows[1] * py + rows[2]  * pz + rows[3]);
+        store(y.data() + i, rows[4] * px + rows[5] * py + rows[6]  * pz + rows[7]);
+        store(z.data() + i, rows[8] * px + rows[9] * py + rows[10] * pz + rows[11]);
+    }
+}
+
+auto PointArray::translate(Point const &offset) -> void
+{
+    using namespace simd;
+
+    Floats const dx = broadcast(offset.x);
+    Floats const dy = broadcast(offset.y);
+    Floats const dz = broadcast(offset.z);
+
+    for (std::size_t i = 0; i < x.size(); i += width)
+    {
+        store(x.data() + i, load(x.data() + i) + dx);
+        store(y.data() + i, load(y.data() + i) + dy);
+        store(z.data() + i, load(z.data() + i) + dz);
+    }
+}
+
+auto PointArray::scale(float factor, Point const &origin) -> void
+{
+    using namespace simd;
+
+    Floats const f  = broadcast(factor);
+    Floats const ox = broadcast(origin.x);
+    Floats const oy = broadcast(origin.y);
+    Floats const oz = broadcast(origin.z);
+
+    for (std::size_t i = 0; i < x.size(); i += width)
+    {
+        store(x.data() + i, ox + (load(x.data() + i) - ox) * f);
+        store(y.data() + i, oy + (load(y.data() + i) - oy) * f);
+        store(z.data() + i, oz + (load(z.data() + i) - oz) * f);
+    }
+}
+
+/**
+ * Unlike the transforms, the padding must not take part in the reduction. Whole
+ * vectors are reduced lane-wise, and whatever is left over is folded in one
+ * Point at a time.
+ */
+auto PointArray::bounds() const -> MaybeBoundingBox
+{
+    using namespace simd;
+
+    if (count == 0)
+    {
+        return std::nullopt;
+    }
+
+    BoundingBox box{at(0), at(0)};
+
+    std::size_t i = 0;
+    if (count >= width)
+    {
+        Floats minX = load(x.data()), maxX = minX;
+        Floats minY = load(y.data()), maxY = minY;
+        Floats minZ = load(z.data()), maxZ = minZ;
+
+        for (i = width; i + width <= count; i += width)
+        {
+            Floats const px = load(x.data() + i);
+            Floats const py = load(y.data() + i);
+            Floats const pz = load(z.data() + i);
+
+            minX = min(minX, px); maxX = max(maxX, px);
+            minY = min(minY, py); maxY = max(maxY, py);
+            minZ = min(minZ, pz); maxZ = max(maxZ, pz);
+        }
+
+        std::array<float, width> lows[3], highs[3];
+        store(lows[0].data(), minX); store(highs[0].data(), maxX);
+        store(lows[1].data(), minY); store(highs[1].data(), maxY);
+        store(lows[2].data(), minZ); store(highs[2].data(), maxZ);
+
+        for (std::size_t lane = 0; lane < width; lane++)
+        {
+            box.expand(Point{lows[0][lane], lows[1][lane], lows[2][lane]});
+            box.expand(Point{highs[0][lane], highs[1][lane], highs[2][lane]});
+        }
+    }
+
+    for (; i < count; i++)
+    {
+        box.expand(at(i));
+    }
+
+    return box;
+}
+
+/**
+ * The minimums start at +infinity and the maximums at -infinity, and each
+ * masked-out Point is swapped for those before it's folded in, so it can never
+ * win. If nothing was left in, the box comes out inside out.
+ */
+auto PointArray::bounds(std::span<float const> mask) const -> MaybeBoundingBox
+{
+    using namespace simd;
+
+    if (mask.size() < count)
+    {
+        throw std::out_of_range("PointArray::bounds");
+    }
+
+    float constexpr inf = std::numeric_limits<float>::infinity();
+    Floats const high = broadcast(inf);
+    Floats const low  = broadcast(-inf);
+    Floats const zero = broadcast(0);
+
+    Floats minX = high, maxX = low;
+    Floats minY = high, maxY = low;
+    Floats minZ = high, maxZ = low;
+
+    std::size_t i = 0;
+    for (; i + width <= count; i += width)
+    {
+        Mask const excluded = load(mask.data() + i) == zero;
+
+        Floats const px = load(x.data() + i);
+        Floats const py = load(y.data() + i);
+        Floats const pz = load(z.data() + i);
+
+        minX = min(minX, select(excluded, high, px)); maxX = max(maxX, select(excluded, low, px));
+        minY = min(minY, select(excluded, high, py)); maxY = max(maxY, select(excluded, low, py));
+        minZ = min(minZ, select(excluded, high, pz)); maxZ = max(maxZ, select(excluded, low, pz));
+    }
+
+    std::array<float, width> lows[3], highs[3];
+    store(lows[0].data(), minX); store(highs[0].data(), maxX);
+    store(lows[1].data(), minY); store(highs[1].data(), maxY);
+    store(lows[2].data(), minZ); store(highs[2].data(), maxZ);
+
+    BoundingBox box{{inf, inf, inf}, {-inf, -inf, -inf}};
+    for (std::size_t lane = 0; lane < width; lane++)
+    {
+        box.min = {std::min(box.min.x, lows[0][lane]), std::min(box.min.y, lows[1][lane]),
+                   std::min(box.min.z, lows[2][lane])};
+        box.max = {std::max(box.max.x, highs[0][lane]), std::max(box.max.y, highs[1][lane]),
+                   std::max(box.max.z, highs[2][lane])};
+    }
+
+    for (; i < count; i++)
+    {
+        if (mask[i] != 0)
+        {
+            box.min = {std::min(box.min.x, x[i]), std::min(box.min.y, y[i]), std::min(box.min.z, z[i])};
+            box.max = {std::max(box.max.x, x[i]), std::max(box.max.y, y[i]), std::max(box.max.z, z[i])};
+        }
+    }
+
+    if (box.min.x > box.max.x)
+    {
+        return std::nullopt;
+    }
+
+    return box;
+}
+
+auto PointArray::distancesTo(Point const &p, std::span<float> out) const -> bool
+{
+    using namespace simd;
+
+    if (out.size() < count)
+    {
+        return false;
+    }
+
+    Floats const px = broadcast(p.x);
+    Floats const py = broadcast(p.y);
+    Floats const pz = broadcast(p.z);
+
+    std::size_t i = 0;
+    for (; i + width <= count; i += width)
+    {
+        Floats const dx = load(x.data() + i) - px;
+        Floats const dy = load(y.data() + i) - py;
+        Floats const dz = load(z.data() + i) - pz;
+
+        store(out.data() + i, sqrt(dx * dx + dy * dy + dz * dz));
+    }
+
+    for (; i < count; i++)
+    {
+        float const dx = x[i] - p.x;
+        float const dy = y[i] - p.y;
+        float const dz = z[i] - p.z;
+
+        out[i] = std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    return true;
+}
+
+auto PointArray::resizeLanes(std::size_t n) -> void
+{
+    x.resize(padded(n), 0);
+    y.resize(padded(n), 0);
+    z.resize(padded(n), 0);
+}
+
+auto mycad::operator<<(std::ostream &stream, PointArray const &points) -> std::ostream &
+{
+    stream << "PointArray: [";
+    for (std::size_t i = 0; i < points.size(); i++)
+    {
+        stream << (i == 0 ? "" : ", ") << points.at(i);
+    }
+    stream << "]";
+
+    return stream;
+}
@@ -0,0 +1,479 @@
+#include "mycad/SpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <ranges>
+
+using namespace mycad;
+
+namespace
+{
+    // Only there to keep the conversion from float defined: no real drawing
+    // gets near it, and the sums and differences of cell coordinates in the
+    // searches can't overflow.
+    std::int64_t constexpr cellLimit = std::int64_t{1} << 60;
+
+    std::size_t constexpr none = std::numeric_limits<std::size_t>::max();
+
+    // Works for a Cell or a Cell const, so that an axis can be looked up or
+    // set by number
+    template <typename C>
+    auto coordinate(C &c, std::size_t axis) -> decltype((c.x))
+    {
+        return axis == 0 ? c.x : axis == 1 ? c.y : c.z;
+    }
+
+    auto squaredDistance(Point const &a, Point const &b) -> float
+    {
+        float const dx = a.x - b.x;
+        float const dy = a.y - b.y;
+        float const dz = a.z - b.z;
+
+        return dx * dx + dy * dy + dz * dz;
+    }
+}
+
+PointGrid::PointGrid(float cellSize)
+    : cellSize(cellSize){}
+
+auto PointGrid::size() const -> std::size_t
+{
+    return count;
+}
+
+auto PointGrid::contains(std::size_t id) const -> bool
+{
+    return id < present.size() && present[id];
+}
+
+auto PointGrid::reserve(std::size_t n) -> void
+{
+    positions.reserve(n);
+    present.reserve(n);
+    next.reserve(n);
+    cells.reserve(n);
+}
+
+auto PointGrid::insert(std::size_t id, Point const &p) -> bool
+{
+    if (contains(id))
+    {
+        return false;
+    }
+
+    if (id >= positions.size())
+    {
+        positions.resize(id + 1);
+        present.resize(id + 1);
+        next.resize(id + 1, none);
+    }
+
+    Cell const c = cellOf(p);
+    auto const [cell, added] = cells.try_emplace(c, none);
+    if (added)
+    {
+        occupy(c);
+    }
+    next[id] = cell->second;
+    cell->second = id;
+
+    positions[id] = p;
+    present[id] = true;
+    count++;
+
+    return true;
+}
+
+auto PointGrid::remove(std::size_t id) -> bool
+{
+    if (not contains(id))
+    {
+        return false;
+    }
+
+    auto const cell = cells.find(cellOf(positions[id]));
+
+    // Cells only hold a few Points, so finding the link to cut is quick
+    std::size_t *link = &cell->second;
+    while (*link != id)
+    {
+        link = &next[*link];
+    }
+    *link = next[id];
+
+    if (cell->second == none)
+    {
+        vacate(cell->first);
+        cells.erase(cell);
+    }
+
+    present[id] = false;
+    count--;
+
+    return true;
+}
+
+auto PointGrid::move(std::size_t id, Point const &p) -> bool
+{
+    if (not contains(id))
+    {
+        return false;
+    }
+
+    if (cellOf(p) == cellOf(positions[id]))
+    {
+        positions[id] = p;
+        return true;
+    }
+
+    remove(id);
+    return insert(id, p);
+}
+
+/**
+ * The search visits shells of cells around the query's cell, one ring further
+ * out each time. A Point in ring `r` is at least `(r - 1) * cellSize` away, so
+ * once that is further than the closest Point so far there's nothing left to
+ * find. Only the faces of each ring are visited, clipped to the occupied
+ * cells, so a flat drawing costs O(r) cells per ring rather than O(r²). Once
+ * the rings add up to more cells than are occupied, the occupied ones are
+ * scanned instead, so no query costs much more than O(occupied cells).
+ */
+auto PointGrid::nearest(Point const &p, float maxDistance) const -> MaybeNeighbour
+{
+    if (count == 0)
+    {
+        return std::nullopt;
+    }
+
+    Cell const c = cellOf(p);
+
+    auto gap = [](std::int64_t x, std::int64_t lo, std::int64_t hi)
+    {
+        return std::max({lo - x, x - hi, std::int64_t{0}});
+    };
+    auto reach = [](std::int64_t x, std::int64_t lo, std::int64_t hi)
+    {
+        return std::max(x - lo, hi - x);
+    };
+
+    std::int64_t const firstRing = std::max({gap(c.x, low.x, high.x),
+                                             gap(c.y, low.y, high.y),
+                                             gap(c.z, low.z, high.z)});
+    std::int64_t const lastRing = std::max({reach(c.x, low.x, high.x),
+                                            reach(c.y, low.y, high.y),
+                                            reach(c.z, low.z, high.z)});
+
+    MaybeNeighbour best;
+    float bestSquared = maxDistance * maxDistance;
+
+    auto check = [&](std::size_t head)
+    {
+        for (std::size_t id = head; id != none; id = next[id])
+        {
+            float const d = squaredDistance(positions[id], p);
+            if (d < bestSquared || (not best.has_value() && d <= bestSquared))
+            {
+                bestSquared = d;
+                best = Neighbour{id, 0};
+            }
+        }
+    };
+
+    // Every cell in [from, to], which is empty if any from is past its to
+    auto visit = [&](Cell const &from, Cell const &to)
+    {
+        for (std::int64_t x = from.x; x <= to.x; x++)
+        {
+            for (std::int64_t y = from.y; y <= to.y; y++)
+            {
+                for (std::int64_t z = from.z; z <= to.z; z++)
+                {
+                    auto const cell = cells.find({x, y, z});
+                    if (cell != cells.end())
+                    {
+                        check(cell->second);
+                    }
+                }
+            }
+        }
+    };
+
+    auto extent = [](std::int64_t from, std::int64_t to)
+    {
+        return from <= to ? double(to - from + 1) : 0.0;
+    };
+
+    double visited = 0;
+    for (std::int64_t r = firstRing; r <= lastRing; r++)
+    {
+        float const closest = static_cast<float>(r - 1) * cellSize;
+        if (r > 0 && closest * closest > bestSquared)
+        {
+            break;
+        }
+
+        // The ring clipped to the occupied cells, and the part of it that is
+        // strictly inside the ring in x and y
+        Cell const lo{std::max(c.x - r, low.x), std::max(c.y - r, low.y), std::max(c.z - r, low.z)};
+        Cell const hi{std::min(c.x + r, high.x), std::min(c.y + r, high.y), std::min(c.z + r, high.z)};
+        std::int64_t const innerXLow  = std::max(c.x - r + 1, low.x);
+        std::int64_t const innerXHigh = std::min(c.x + r - 1, high.x);
+        std::int64_t const innerYLow  = std::max(c.y - r + 1, low.y);
+        std::int64_t const innerYHigh = std::min(c.y + r - 1, high.y);
+
+        bool const left   = c.x - r >= low.x;
+        bool const right  = r > 0 && c.x + r <= high.x;
+        bool const front  = c.y - r >= low.y;
+        bool const back   = r > 0 && c.y + r <= high.y;
+        bool const bottom = c.z - r >= low.z;
+        bool const top    = r > 0 && c.z + r <= high.z;
+
+        double const xFace = extent(lo.y, hi.y) * extent(lo.z, hi.z);
+        double const yFace = extent(innerXLow, innerXHigh) * extent(lo.z, hi.z);
+        double const zFace = extent(innerXLow, innerXHigh) * extent(innerYLow, innerYHigh);
+        double const span = xFace * (left + right) + yFace * (front + back) +
+                            zFace * (bottom + top);
+        visited += span;
+        if (visited > static_cast<double>(cells.size()))
+        {
+            for (auto const &[_, head] : cells)
+            {
+                check(head);
+            }
+            break;
+        }
+
+        if (left)
+        {
+            visit({c.x - r, lo.y, lo.z}, {c.x - r, hi.y, hi.z});
+        }
+        if (right)
+        {
+            visit({c.x + r, lo.y, lo.z}, {c.x + r, hi.y, hi.z});
+        }
+        if (front)
+        {
+            visit({innerXLow, c.y - r, lo.z}, {innerXHigh, c.y - r, hi.z});
+        }
+        if (back)
+        {
+            visit({innerXLow, c.y + r, lo.z}, {innerXHigh, c.y + r, hi.z});
+        }
+        if (bottom)
+        {
+            visit({innerXLow, innerYLow, c.z - r}, {innerXHigh, innerYHigh, c.z - r});
+        }
+        if (top)
+        {
+            visit({innerXLow, innerYLow, c.z + r}, {innerXHigh, innerYHigh, c.z + r});
+        }
+    }
+
+    if (best.has_value())
+    {
+        best->distance = std::sqrt(bestSquared);
+    }
+
+    return best;
+}
+
+auto PointGrid::withinRadius(Point const &p, float radius) const -> Neighbours
+{
+    Neighbours out;
+    if (count == 0)
+    {
+        return out;
+    }
+
+    float const radiusSquared = radius * radius;
+    auto check = [&](std::size_t head)
+    {
+        for (std::size_t id = head; id != none; id = next[id])
+        {
+            float const d = squaredDistance(positions[id], p);
+            if (d <= radiusSquared)
+            {
+                out.push_back({id, std::sqrt(d)});
+            }
+        }
+    };
+
+    Cell const from = cellOf({p.x - radius, p.y - radius, p.z - radius});
+    Cell const to   = cellOf({p.x + radius, p.y + radius, p.z + radius});
+
+    Cell const lo{std::max(from.x, low.x), std::max(from.y, low.y), std::max(from.z, low.z)};
+    Cell const hi{std::min(to.x, high.x), std::min(to.y, high.y), std::min(to.z, high.z)};
+    if (lo.x > hi.x || lo.y > hi.y || lo.z > hi.z)
+    {
+        return out;
+    }
+
+    // If the query covers more cells than are occupied, it's quicker to just
+    // look at the occupied ones
+    double const span = double(hi.x - lo.x + 1) * double(hi.y - lo.y + 1) *
+                        double(hi.z - lo.z + 1);
+    if (span > static_cast<double>(cells.size()))
+    {
+        for (auto const &[_, head] : cells)
+        {
+            check(head);
+        }
+        return out;
+    }
+
+    for (std::int64_t x = lo.x; x <= hi.x; x++)
+    {
+        for (std::int64_t y = lo.y; y <= hi.y; y++)
+        {
+            for (std::int64_t z = lo.z; z <= hi.z; z++)
+            {
+                auto const cell = cells.find({x, y, z});
+                if (cell != cells.end())
+                {
+                    check(cell->second);
+                }
+            }
+        }
+    }
+
+    return out;
+}
+
+auto PointGrid::nearest(std::span<Point const> queries,
+                        std::span<MaybeNeighbour> out,
+                        float maxDistance) const -> bool
+{
+    if (out.size() < queries.size())
+    {
+        return false;
+    }
+
+    std::vector<Cell> queryCells(queries.size());
+    std::ranges::transform(queries, queryCells.begin(),
+                           [this](Point const &p){return cellOf(p);});
+
+    std::vector<std::size_t> order(queries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, {}, [&queryCells](std::size_t i){return queryCells[i];});
+
+    for (std::size_t const i : order)
+    {
+        out[i] = nearest(queries[i], maxDistance);
+    }
+
+    return true;
+}
+
+/**
+ * Only a new cell can widen the range, which is O(1). It only narrows when the
+ * last cell at a coordinate on its edge is emptied, and then the new edge is
+ * found by stepping inwards, or by looking at every occupied coordinate on
+ * that axis if that's fewer steps. Clearing a drawing from one side therefore
+ * stays O(1) per cell.
+ */
+auto PointGrid::occupy(Cell const &c) -> void
+{
+    bool const first = cells.size() == 1;
+    for (std::size_t axis = 0; axis < 3; axis++)
+    {
+        std::int64_t const at = coordinate(c, axis);
+        occupied[axis][at]++;
+
+        coordinate(low, axis)  = first ? at : std::min(coordinate(low, axis), at);
+        coordinate(high, axis) = first ? at : std::max(coordinate(high, axis), at);
+    }
+}
+
+auto PointGrid::vacate(Cell const &c) -> void
+{
+    for (std::size_t axis = 0; axis < 3; axis++)
+    {
+        auto &counts = occupied[axis];
+        std::int64_t const at = coordinate(c, axis);
+
+        auto const found = counts.find(at);
+        if (--found->second > 0)
+        {
+            continue;
+        }
+        counts.erase(found);
+
+        if (counts.empty())
+        {
+            low = {0, 0, 0};
+            high = {-1, -1, -1};
+            return;
+        }
+
+        // What's left is all in [lo, hi], so stepping from one towards the
+        // other always finds the new edge
+        auto refit = [&counts](std::int64_t from, std::int64_t step)
+        {
+            for (std::size_t i = 0; i < counts.size(); i++)
+            {
+                from += step;
+                if (counts.contains(from))
+                {
+                    return from;
+                }
+            }
+
+            auto const keys = counts | std::views::keys;
+            return step > 0 ? std::ranges::min(keys) : std::ranges::max(keys);
+        };
+
+        std::int64_t &lo = coordinate(low, axis);
+        std::int64_t &hi = coordinate(high, axis);
+        if (at == lo)
+        {
+            lo = refit(lo, 1);
+        }
+        if (at == hi)
+        {
+            hi = refit(hi, -1);
+        }
+    }
+}
+
+auto PointGrid::cellOf(Point const &p) const -> Cell
+{
+    // NaN has no cell of its own, so it goes in the one at the origin, and
+    // anything too large for a cell coordinate goes in the last one
+    auto coordinate = [this](float x) -> std::int64_t
+    {
+        double const c = std::floor(double(x) / cellSize);
+        if (std::isnan(c))
+        {
+            return 0;
+        }
+        if (not std::isfinite(c))
+        {
+            return c > 0 ? cellLimit : -cellLimit;
+        }
+        return static_cast<std::int64_t>(std::clamp(c, double(-cellLimit), double(cellLimit)));
+    };
+
+    return {coordinate(p.x), coordinate(p.y), coordinate(p.z)};
+}
+
+/**
+ * Each coordinate is mixed with a different odd constant and then the whole
+ * lot is folded through a splitmix64 finaliser, so that neighbouring cells
+ * (which is what a drawing fills) land in unrelated buckets.
+ */
+auto PointGrid::CellHash::operator()(Cell const &c) const -> std::size_t
+{
+    std::uint64_t h = static_cast<std::uint64_t>(c.x) * 0x9e3779b97f4a7c15ull;
+    h ^= static_cast<std::uint64_t>(c.y) * 0xc2b2ae3d27d4eb4full;
+    h ^= static_cast<std::uint64_t>(c.z) * 0x165667b19e3779f9ull;
+
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+
+    return static_cast<std::size_t>(h);
+}
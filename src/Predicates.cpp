@@ -0,0 +1,325 @@
+#include "mycad/Predicates.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace mycad;
+
+/**
+ * The filters and the exact fall-back follow Jonathan Shewchuk's "Adaptive
+ * Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates".
+ *
+ * Everything is evaluated in double, which holds every float exactly. The
+ * error bounds are those of the paper for double precision.
+ */
+namespace
+{
+    double constexpr epsilon = std::numeric_limits<double>::epsilon() / 2;
+
+    double constexpr ccwErrorBound = (3.0 + 16.0 * epsilon) * epsilon;
+    double constexpr o3dErrorBound = (7.0 + 56.0 * epsilon) * epsilon;
+
+    auto toOrientation(double det) -> Orientation
+    {
+        return det > 0 ? Orientation::Positive
+             : det < 0 ? Orientation::Negative
+             :           Orientation::Zero;
+    }
+
+    /** @brief an exact sum of non-overlapping doubles, smallest first
+     *
+     *  Only used on the slow path, so it favours simplicity over speed.
+     */
+    class Expansion
+    {
+        public:
+            explicit Expansion(double a)
+            {
+                grow(a);
+            }
+
+            /** @brief exactly @param a - @param b
+             */
+            static auto difference(double a, double b) -> Expansion
+            {
+                Expansion out(0);
+                out.terms.clear();
+
+                double const x = a - b;
+                double const bVirtual = a - x;
+                double const aVirtual = x + bVirtual;
+                double const y = (a - aVirtual) + (bVirtual - b);
+
+                out.grow(y);
+                out.grow(x);
+                return out;
+            }
+
+            auto operator+(Expansion const &other) const -> Expansion
+            {
+                Expansion out = *this;
+                for (double const term : other.terms)
+                {
+                    out.grow(term);
+                }
+                return out;
+            }
+
+            auto operator-(Expansion const &other) const -> Expansion
+            {
+                Expansion out = *this;
+                for (double const term : other.terms)
+                {
+                    out.grow(-term);
+                }
+                return out;
+            }
+
+            auto operator*(Expansion const &other) const -> Expansion
+            {
+                Expansion out(0);
+                for (double const a : terms)
+                {
+                    for (double const b : other.terms)
+                    {
+                        // a * b == x + y exactly
+                        double const x = a * b;
+                        double const y = std::fma(a, b, -x);
+                        out.grow(y);
+                        out.grow(x);
+                    }
+                }
+                return out;
+            }
+
+            /** @brief the sign of the sum is the sign of its largest term
+             */
+            auto sign() const -> Orientation
+            {
+                return terms.empty() ? Orientation::Zero : toOrientation(terms.back());
+            }
+        private:
+            /** @brief adds @param b, keeping the terms non-overlapping and
+             *         dropping any that are zero
+             */
+            auto grow(double b) -> void
+            {
+                std::size_t n = 0;
+                double q = b;
+                for (double const term : terms)
+                {
+                    // q + term == sum + error exactly
+                    double const sum = q + term;
+                    double const bVirtual = sum - q;
+                    double const aVirtual = sum - bVirtual;
+                    double const error = (q - aVirtual) + (term - bVirtual);
+
+                    if (error != 0)
+                    {
+                        terms[n++] = error;
+                    }
+                    q = sum;
+                }
+
+                terms.resize(n);
+                if (q != 0)
+                {
+                    terms.push_back(q);
+                }
+            }
+
+            std::vector<double> terms{};
+    };
+
+    auto orient2dExact(Point const &a, Point const &b, Point const &c) -> Orientation
+    {
+        auto const acx = Expansion::difference(a.x, c.x);
+        auto const bcy = Expansion::difference(b.y, c.y);
+        auto const acy = Expansion::difference(a.y, c.y);
+        auto const bcx = Expansion::difference(b.x, c.x);
+
+        return (acx * bcy - acy * bcx).sign();
+    }
+
+    auto orient3dExact(Point const &a, Point const &b, Point const &c,
+                       Point const &d) -> Orientation
+    {
+        auto const adx = Expansion::difference(a.x, d.x);
+        auto const bdx = Expansion::difference(b.x, d.x);
+        auto const cdx = Expansion::difference(c.x, d.x);
+        auto const ady = Expansion::difference(a.y, d.y);
+        auto const bdy = Expansion::difference(b.y, d.y);
+        auto const cdy = Expansion::difference(c.y, d.y);
+        auto const adz = Expansion::difference(a.z, d.z);
+        auto const bdz = Expansion::difference(b.z, d.z);
+        auto const cdz = Expansion::difference(c.z, d.z);
+
+        return (adz * (bdx * cdy - cdx * bdy) +
+                bdz * (cdx * ady - adx * cdy) +
+                cdz * (adx * bdy - bdx * ady)).sign();
+    }
+
+    auto distanceToSegment(Line const &line, Point const &p) -> double
+    {
+        Point const p1 = line.atU(0);
+        Point const p2 = line.atU(1);
+
+        double const dx = double(p2.x) - p1.x;
+        double const dy = double(p2.y) - p1.y;
+        double const dz = double(p2.z) - p1.z;
+
+        double const px = double(p.x) - p1.x;
+        double const py = double(p.y) - p1.y;
+        double const pz = double(p.z) - p1.z;
+
+        double const u = std::clamp((px * dx + py * dy + pz * dz) /
+                                    (dx * dx + dy * dy + dz * dz), 0.0, 1.0);
+
+        return std::hypot(px - u * dx, py - u * dy, pz - u * dz);
+    }
+
+    auto distanceToLine(Line const &line, Point const &p) -> double
+    {
+        Point const p1 = line.atU(0);
+        Point const p2 = line.atU(1);
+
+        double const dx = double(p2.x) - p1.x;
+        double const dy = double(p2.y) - p1.y;
+        double const dz = double(p2.z) - p1.z;
+
+        double const px = double(p.x) - p1.x;
+        double const py = double(p.y) - p1.y;
+        double const pz = double(p.z) - p1.z;
+
+        // |d × p| / |d|
+        return std::hypot(dy * pz - dz * py, dz * px - dx * pz, dx * py - dy * px) /
+               std::hypot(dx, dy, dz);
+    }
+}
+
+auto mycad::orient2d(Point const &a, Point const &b, Point const &c) -> Orientation
+{
+    double const detLeft  = (double(a.x) - c.x) * (double(b.y) - c.y);
+    double const detRight = (double(a.y) - c.y) * (double(b.x) - c.x);
+    double const det = detLeft - detRight;
+
+    // If the two products have different signs (or one is zero) there is no
+    // cancellation, and the sign of det can be trusted as is
+    double detSum = 0;
+    if (detLeft > 0)
+    {
+        if (detRight <= 0)
+        {
+            return toOrientation(det);
+        }
+        detSum = detLeft + detRight;
+    }
+    else if (detLeft < 0)
+    {
+        if (detRight >= 0)
+        {
+            return toOrientation(det);
+        }
+        detSum = -detLeft - detRight;
+    }
+    else
+    {
+        return toOrientation(det);
+    }
+
+    double const errorBound = ccwErrorBound * detSum;
+    if (det >= errorBound || -det >= errorBound)
+    {
+        return toOrientation(det);
+    }
+
+    return orient2dExact(a, b, c);
+}
+
+auto mycad::orient3d(Point const &a, Point const &b, Point const &c,
+                     Point const &d) -> Orientation
+{
+    double const adx = double(a.x) - d.x, ady = double(a.y) - d.y, adz = double(a.z) - d.z;
+    double const bdx = double(b.x) - d.x, bdy = double(b.y) - d.y, bdz = double(b.z) - d.z;
+    double const cdx = double(c.x) - d.x, cdy = double(c.y) - d.y, cdz = double(c.z) - d.z;
+
+    double const bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    double const cdxady = cdx * ady, adxcdy = adx * cdy;
+    double const adxbdy = adx * bdy, bdxady = bdx * ady;
+
+    double const det = adz * (bdxcdy - cdxbdy) +
+                       bdz * (cdxady - adxcdy) +
+                       cdz * (adxbdy - bdxady);
+
+    double const permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz) +
+                             (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz) +
+                             (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz);
+
+    double const errorBound = o3dErrorBound * permanent;
+    if (det > errorBound || -det > errorBound)
+    {
+        return toOrientation(det);
+    }
+
+    return orient3dExact(a, b, c, d);
+}
+
+/**
+ * (b - a) × (c - a) is zero exactly when the three are collinear, and each of
+ * its components is the orientation of the points projected on to one of the
+ * coordinate planes.
+ */
+auto mycad::collinear(Point const &a, Point const &b, Point const &c) -> bool
+{
+    auto yz = [](Point const &p){return Point{p.y, p.z, 0};};
+    auto zx = [](Point const &p){return Point{p.z, p.x, 0};};
+
+    return orient2d(a, b, c) == Orientation::Zero &&
+           orient2d(yz(a), yz(b), yz(c)) == Orientation::Zero &&
+           orient2d(zx(a), zx(b), zx(c)) == Orientation::Zero;
+}
+
+auto mycad::onSegment(Line const &line, Point const &p) -> bool
+{
+    Point const p1 = line.atU(0);
+    Point const p2 = line.atU(1);
+
+    // Once p is known to be on the line, it's between the ends exactly when
+    // it's inside the box they span. Comparisons are always exact.
+    auto between = [](float a, float b, float x)
+    {
+        return std::min(a, b) <= x && x <= std::max(a, b);
+    };
+
+    return between(p1.x, p2.x, p.x) &&
+           between(p1.y, p2.y, p.y) &&
+           between(p1.z, p2.z, p.z) &&
+           collinear(p1, p2, p);
+}
+
+auto mycad::onSegment(Line const &line, Point const &p, float tolerance) -> bool
+{
+    return distanceToSegment(line, p) <= tolerance;
+}
+
+auto mycad::coincident(Point const &a, Point const &b, float tolerance) -> bool
+{
+    return std::hypot(double(a.x) - b.x, double(a.y) - b.y, double(a.z) - b.z)
+           <= tolerance;
+}
+
+auto mycad::coincident(Line const &a, Line const &b) -> bool
+{
+    return collinear(a.atU(0), a.atU(1), b.atU(0)) &&
+           collinear(a.atU(0), a.atU(1), b.atU(1));
+}
+
+auto mycad::coincident(Line const &a, Line const &b, float tolerance) -> bool
+{
+    return distanceToLine(a, b.atU(0)) <= tolerance &&
+           distanceToLine(a, b.atU(1)) <= tolerance &&
+           distanceToLine(b, a.atU(0)) <= tolerance &&
+           distanceToLine(b, a.atU(1)) <= tolerance;
+}
@@ -0,0 +1,156 @@
+#include "mycad/PreparedLine.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace mycad;
+
+namespace
+{
+    auto component(Point const &p, int axis) -> float
+    {
+        return axis == 0 ? p.x : axis == 1 ? p.y : p.z;
+    }
+}
+
+PreparedLine::PreparedLine(Line const &line)
+    : source(line),
+      start(line.atU(0)),
+      bounds(makeBoundingBox(line))
+{
+    Point const end = line.atU(1);
+    delta = {end.x - start.x, end.y - start.y, end.z - start.z};
+    inverseDelta = {1 / delta.x, 1 / delta.y, 1 / delta.z};
+
+    squaredLength = delta.x * delta.x + delta.y * delta.y + delta.z * delta.z;
+
+    // The ends of a Line always differ, but a very short one can still have
+    // a squared length that rounds to zero. Treat it as a single point.
+    inverseSquaredLength = squaredLength > 0 ? 1 / squaredLength : 0;
+    oneOverLength = std::sqrt(inverseSquaredLength);
+}
+
+auto PreparedLine::line() const -> Line const &
+{
+    return source;
+}
+
+auto PreparedLine::atU(float u) const -> Point
+{
+    return source.atU(u);
+}
+
+auto PreparedLine::direction() const -> Point const &
+{
+    return delta;
+}
+
+auto PreparedLine::lengthSquared() const -> float
+{
+    return squaredLength;
+}
+
+auto PreparedLine::length() const -> float
+{
+    return squaredLength * oneOverLength;
+}
+
+auto PreparedLine::inverseLength() const -> float
+{
+    return oneOverLength;
+}
+
+auto PreparedLine::box() const -> BoundingBox const &
+{
+    return bounds;
+}
+
+auto PreparedLine::project(Point const &p) const -> float
+{
+    float const px = p.x - start.x;
+    float const py = p.y - start.y;
+    float const pz = p.z - start.z;
+
+    return (px * delta.x + py * delta.y + pz * delta.z) * inverseSquaredLength;
+}
+
+auto PreparedLine::closestPoint(Point const &p) const -> Point
+{
+    float const u = std::clamp(project(p), 0.0f, 1.0f);
+
+    return {start.x + u * delta.x, start.y + u * delta.y, start.z + u * delta.z};
+}
+
+auto PreparedLine::distanceSquared(Point const &p) const -> float
+{
+    Point const q = closestPoint(p);
+    float const dx = p.x - q.x;
+    float const dy = p.y - q.y;
+    float const dz = p.z - q.z;
+
+    return dx * dx + dy * dy + dz * dz;
+}
+
+auto PreparedLine::distance(Point const &p) const -> float
+{
+    return std::sqrt(distanceSquared(p));
+}
+
+auto PreparedLine::contains(Point const &p, float tolerance) const -> bool
+{
+    if (p.x < bounds.min.x - tolerance || p.x > bounds.max.x + tolerance ||
+        p.y < bounds.min.y - tolerance || p.y > bounds.max.y + tolerance ||
+        p.z < bounds.min.z - tolerance || p.z > bounds.max.z + tolerance)
+    {
+        return false;
+    }
+
+    return distanceSquared(p) <= tolerance * tolerance;
+}
+
+/**
+ * This clips the range of u from 0 to 1 against each pair of faces of the box
+ * in turn (the "slab" test), multiplying by the stored inverse direction
+ * rather than dividing by the direction.
+ */
+auto PreparedLine::crosses(BoundingBox const &other) const -> bool
+{
+    if (not bounds.intersects(other))
+    {
+        return false;
+    }
+
+    float uMin = 0;
+    float uMax = 1;
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+        float const a  = component(start, axis);
+        float const lo = component(other.min, axis);
+        float const hi = component(other.max, axis);
+
+        if (component(delta, axis) == 0)
+        {
+            // Parallel to these faces, and already known to be between them
+            // from the box test
+            continue;
+        }
+
+        float const inverse = component(inverseDelta, axis);
+        float u1 = (lo - a) * inverse;
+        float u2 = (hi - a) * inverse;
+        if (u1 > u2)
+        {
+            std::swap(u1, u2);
+        }
+
+        uMin = std::max(uMin, u1);
+        uMax = std::min(uMax, u2);
+        if (uMin > uMax)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,189 @@
+#include "mycad/Simplify.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <thread>
+
+using namespace mycad;
+
+namespace
+{
+    std::uint32_t constexpr none = std::numeric_limits<std::uint32_t>::max();
+
+    // A thread costs more to start than simplifying a handful of short
+    // Chains, so the default thread count gives each at least this many
+    std::size_t constexpr minChainsPerThread = 64;
+
+    /** @returns the distance from @param p to the segment from @param a to
+     *           @param b, or to @param a if they're the same
+     *
+     *  A segment rather than the whole line through them, so that a spike
+     *  doubling back along it still counts as far away.
+     */
+    auto offset(Point const &a, Point const &p, Point const &b) -> float
+    {
+        double const dx = double(b.x) - a.x;
+        double const dy = double(b.y) - a.y;
+        double const dz = double(b.z) - a.z;
+
+        double const px = double(p.x) - a.x;
+        double const py = double(p.y) - a.y;
+        double const pz = double(p.z) - a.z;
+
+        double const baseSquared = dx * dx + dy * dy + dz * dz;
+        if (baseSquared == 0)
+        {
+            return static_cast<float>(std::hypot(px, py, pz));
+        }
+
+        double const t = std::clamp((dx * px + dy * py + dz * pz) / baseSquared, 0.0, 1.0);
+        return static_cast<float>(std::hypot(px - t * dx, py - t * dy, pz - t * dz));
+    }
+
+    struct Candidate
+    {
+        float distance;
+        std::uint32_t index;
+
+        // Candidates are never removed from the queue. Instead, a Point is
+        // re-measured by pushing it again with a new stamp, and any entry
+        // whose stamp is out of date is skipped when it comes out.
+        std::uint32_t stamp;
+
+        auto operator>(Candidate const &other) const -> bool
+        {
+            return distance > other.distance ||
+                   (distance == other.distance && index > other.index);
+        }
+    };
+}
+
+auto mycad::simplify(std::span<Point const> points, float tolerance) -> Polyline
+{
+    std::size_t const n = points.size();
+    if (n <= 2)
+    {
+        return Polyline(points.begin(), points.end());
+    }
+
+    std::vector<std::uint32_t> previous(n), next(n), stamps(n, 0);
+    for (std::uint32_t i = 0; i < n; i++)
+    {
+        previous[i] = i == 0 ? none : i - 1;
+        next[i] = i + 1 == n ? none : i + 1;
+    }
+
+    auto measure = [&](std::uint32_t i)
+    {
+        return Candidate{offset(points[previous[i]], points[i], points[next[i]]), i, stamps[i]};
+    };
+
+    std::vector<Candidate> initial;
+    initial.reserve(n - 2);
+    for (std::uint32_t i = 1; i + 1 < n; i++)
+    {
+        initial.push_back(measure(i));
+    }
+
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>>
+        queue(std::greater<>{}, std::move(initial));
+
+    std::vector<bool> kept(n, true);
+    while (not queue.empty())
+    {
+        Candidate const best = queue.top();
+        if (best.distance > tolerance)
+        {
+            break;
+        }
+        queue.pop();
+
+        std::uint32_t const i = best.index;
+        if (best.stamp != stamps[i])
+        {
+            continue;
+        }
+
+        kept[i] = false;
+        std::uint32_t const before = previous[i];
+        std::uint32_t const after = next[i];
+        next[before] = after;
+        previous[after] = before;
+
+        // The ends are never candidates, so only re-measure the neighbours
+        // that are in the middle
+        for (std::uint32_t const j : {before, after})
+        {
+            if (previous[j] != none && next[j] != none)
+            {
+                stamps[j]++;
+                queue.push(measure(j));
+            }
+        }
+    }
+
+    Polyline out;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        if (kept[i])
+        {
+            out.push_back(points[i]);
+        }
+    }
+
+    return out;
+}
+
+/**
+ * Chains vary a lot in length, so rather than splitting them up front each
+ * thread takes the next Chain that nobody has started yet.
+ */
+auto mycad::simplifyChains(Entity const &entity, std::span<Chain const> chains,
+                           float tolerance, unsigned threads) -> std::vector<Polyline>
+{
+    std::vector<Polyline> out(chains.size());
+
+    std::atomic<std::size_t> next = 0;
+    auto work = [&]()
+    {
+        for (std::size_t i = next++; i < chains.size(); i = next++)
+        {
+            auto const geometry = entity.getChainGeometry(chains[i]);
+            if (geometry.has_value())
+            {
+                out[i] = simplify(geometry->points(), tolerance);
+            }
+        }
+    };
+
+    if (threads == 0)
+    {
+        std::size_t const most = std::max<std::size_t>(1, chains.size() / minChainsPerThread);
+        threads = static_cast<unsigned>(std::min<std::size_t>(
+            std::max(1u, std::thread::hardware_concurrency()), most));
+    }
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, chains.size()));
+
+    if (threads <= 1)
+    {
+        work();
+        return out;
+    }
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; t++)
+    {
+        workers.emplace_back(work);
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    return out;
+}
@@ -0,0 +1,139 @@
+#include "mycad/Tessellator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+using namespace mycad;
+
+namespace
+{
+    std::size_t constexpr maxSegments = 1 << 16;
+}
+
+/**
+ * A chord across an angle θ of a circle of radius r is furthest from the
+ * circle at its middle, where the gap (the sagitta) is r(1 - cos(θ/2)).
+ * Solving for θ gives the largest angle each segment may cover.
+ */
+auto mycad::segmentCount(float radius, float sweep, float tolerance) -> std::size_t
+{
+    double const turn = std::abs(double(sweep));
+    std::size_t const fewest = turn >= 2 * std::numbers::pi ? 3 : 1;
+
+    if (not (tolerance > 0))
+    {
+        return maxSegments;
+    }
+
+    double const ratio = std::min(double(tolerance) / radius, 1.0);
+    double const step = 2 * std::acos(1 - ratio);
+    double const n = std::ceil(turn / step);
+
+    return std::clamp(static_cast<std::size_t>(std::min(n, double(maxSegments))), fewest, maxSegments);
+}
+
+Tessellator::Tessellator(float pixelTolerance, float pixelsPerUnit)
+    : pixelTolerance(pixelTolerance), pixelsPerUnit(pixelsPerUnit){}
+
+/**
+ * The bands are the outer keys of the cache, so everything outside the
+ * current one's neighbours comes off either end in two range erases.
+ */
+auto Tessellator::setScale(float scale) -> void
+{
+    pixelsPerUnit = scale;
+
+    int const current = band();
+    int const lowest = current == std::numeric_limits<int>::min() ? current : current - 1;
+    int const highest = current == std::numeric_limits<int>::max() ? current : current + 1;
+
+    cache.erase(cache.begin(), cache.lower_bound(lowest));
+    cache.erase(cache.upper_bound(highest), cache.end());
+}
+
+auto Tessellator::tolerance() const -> float
+{
+    return std::ldexp(1.0f, band());
+}
+
+auto Tessellator::profile(Arc const &arc) -> std::span<Point const>
+{
+    Shape const key{arc.radius(), arc.startAngle(), arc.sweep()};
+    int const current = band();
+
+    auto const [found, added] = cache[current].try_emplace(key);
+    std::vector<Point> &points = found->second;
+    if (not added)
+    {
+        return points;
+    }
+
+    std::size_t const n = segmentCount(key.radius, key.sweep, std::ldexp(1.0f, current));
+    points.reserve(n + 1);
+    for (std::size_t i = 0; i <= n; i++)
+    {
+        double const angle = key.startAngle + key.sweep * static_cast<double>(i) / static_cast<double>(n);
+        points.push_back({static_cast<float>(key.radius * std::cos(angle)),
+                          static_cast<float>(key.radius * std::sin(angle)),
+                          0});
+    }
+
+    if (arc.closed())
+    {
+        points.back() = points.front();
+    }
+
+    return points;
+}
+
+auto Tessellator::profile(Circle const &circle) -> std::span<Point const>
+{
+    return profile(circle.asArc());
+}
+
+auto Tessellator::tessellate(Arc const &arc, std::vector<Point> &out) -> void
+{
+    Point const &c = arc.center();
+    for (Point const &p : profile(arc))
+    {
+        out.push_back({c.x + p.x, c.y + p.y, c.z});
+    }
+}
+
+auto Tessellator::tessellate(Circle const &circle, std::vector<Point> &out) -> void
+{
+    tessellate(circle.asArc(), out);
+}
+
+auto Tessellator::cacheSize() const -> std::size_t
+{
+    std::size_t out = 0;
+    for (auto const &[_, shapes] : cache)
+    {
+        out += shapes.size();
+    }
+
+    return out;
+}
+
+auto Tessellator::clear() -> void
+{
+    cache.clear();
+}
+
+/**
+ * Rounding down means the tolerance used is never looser than the one asked
+ * for, but at most twice as tight.
+ */
+auto Tessellator::band() const -> int
+{
+    float const worldTolerance = pixelTolerance / pixelsPerUnit;
+    if (not (worldTolerance > 0))
+    {
+        return std::numeric_limits<int>::min();
+    }
+
+    return std::ilogb(worldTolerance);
+}
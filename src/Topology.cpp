@@ -58,7 +58,7 @@ auto Topology::hasVertex(VertexID v) const -> bool
     }
     else
     {
-        return true;
+        return vertices[v].index.has_value();
     }
 }
 
@@ -73,8 +73,24 @@ auto Topology::hasChain(Chain c) const -> bool
     return maybeEdges.has_value() ? maybeEdges.value().size() : false;
 }
 
+auto Topology::vertexCount() const -> std::size_t
+{
+    return vertices.size();
+}
+
+auto Topology::edgeIDs() const -> EdgeIDs
+{
+    auto view = edges | views::keys;
+    return EdgeIDs(view.begin(), view.end());
+}
+
 auto Topology::addFreeVertex() -> VertexID
 {
+    if (batch)
+    {
+        batch->journal.push_back({.kind = detail::Undo::Kind::AddVertex});
+    }
+
     return vertices.emplace_back(vertices.size()).index.value();
 }
 
@@ -94,14 +110,7 @@ auto Topology::makeEdge(VertexID v1, VertexID v2) -> MaybeEdgeID
         return std::nullopt;
     }
 
-    auto hasSameVertices = [&v1, &v2](auto pair)
-    {
-        auto const [left, right] = pair.second.ends;
-        return (left == v1 && right == v2) ||
-               (left == v2 && right == v1);
-    };
-
-    if(ranges::any_of(edges, hasSameVertices))
+    if(findEdge(v1, v2).has_value())
     {
         return std::nullopt;
     }
@@ -109,6 +118,18 @@ auto Topology::makeEdge(VertexID v1, VertexID v2) -> MaybeEdgeID
     EdgeID edge(lastEdgeID++);
     edges.emplace(edge, detail::Edge{{v1, v2}});
 
+    if (batch)
+    {
+        batch->added.emplace_back(detail::orderedEnds(v1, v2), edge);
+        batch->journal.push_back({.kind  = detail::Undo::Kind::MakeEdge,
+                                  .edge  = edge,
+                                  .ends  = {v1, v2}});
+    }
+    else
+    {
+        edgeIndex.emplace(detail::orderedEnds(v1, v2), edge);
+    }
+
     // Gather our data from storage
     detail::Vertex &leftVertex = vertices.at(v1);
     detail::Vertex &rightVertex = vertices.at(v2);
@@ -129,27 +150,168 @@ auto Topology::deleteEdge(EdgeID edge) -> bool
     else
     {
         // first delete the edge from the edges map
+        auto const ends = edges.at(edge).ends;
         edges.erase(edge);
 
-        // Now we have to remove any links from the vertex map
+        detail::Undo undo{.kind = detail::Undo::Kind::DeleteEdge,
+                          .edge = edge,
+                          .ends = ends};
+
+        // Now we have to remove any links from the vertex map. Links to an
+        // Edge only ever live on the two Vertices at its ends.
         auto parentEdgeMatches =
             [edge](detail::Link const &link)
                 {
                     return link.parentEdge == edge;
                 };
 
-        ranges::for_each(vertices,
-            [&parentEdgeMatches](auto &vertex)
+        for (VertexID const v : {ends.first, ends.second})
+        {
+            auto &links = vertices.at(v).links;
+
+            for (std::size_t i = 0; i < links.size(); i++)
+            {
+                if (parentEdgeMatches(links.at(i)))
+                {
+                    undo.removedLinks.emplace_back(v, i, links.at(i));
+                }
+            }
+
+            auto const rem = ranges::remove_if(links, parentEdgeMatches);
+            links.erase(rem.begin(), rem.end());
+
+            // a loop Edge has both of its Links on the same Vertex
+            if (ends.first == ends.second)
             {
-                auto const rem = ranges::remove_if(vertex.links, parentEdgeMatches); 
-                vertex.links.erase(rem.begin(), rem.end());
+                break;
             }
-        );
+        }
+
+        auto const key = detail::orderedEnds(ends.first, ends.second);
+        if (batch)
+        {
+            batch->removed.emplace_back(key, edge);
+            batch->journal.push_back(std::move(undo));
+        }
+        else
+        {
+            edgeIndex.erase(key);
+        }
 
         return true;
     }
 }
 
+/**
+ * The Vertex keeps its slot, marked as invalid, so that later VertexIDs still
+ * index the right Vertex.
+ */
+auto Topology::deleteVertex(VertexID v) -> bool
+{
+    if (not hasVertex(v))
+    {
+        return false;
+    }
+
+    // deleteEdge removes Links from this Vertex, so work from a copy
+    auto const view = linksAt(v) | views::transform(&detail::Link::parentEdge);
+    EdgeIDs const adjacent(view.begin(), view.end());
+    for (EdgeID const e : adjacent)
+    {
+        // a loop Edge is listed twice
+        deleteEdge(e);
+    }
+
+    vertices.at(v).index.reset();
+
+    if (batch)
+    {
+        batch->journal.push_back({.kind = detail::Undo::Kind::DeleteVertex, .vertex = v});
+    }
+
+    return true;
+}
+
+/**
+ * New IDs are handed out in the order of the old ones, so the Edges can be
+ * put back into their map (and the Edge index rebuilt) from sorted ranges.
+ */
+auto Topology::compact() -> std::optional<IDRemap>
+{
+    if (batch)
+    {
+        return std::nullopt;
+    }
+
+    IDRemap out;
+    out.vertices.resize(vertices.size());
+    out.edges.resize(static_cast<std::size_t>(lastEdgeID));
+
+    VertexID nextVertex = 0;
+    for (VertexID v = 0; v < vertices.size(); v++)
+    {
+        if (hasVertex(v))
+        {
+            out.vertices[v] = nextVertex++;
+        }
+    }
+
+    EdgeID nextEdge = 0;
+    for (auto const &[e, _] : edges)
+    {
+        out.edges[static_cast<std::size_t>(e)] = nextEdge++;
+    }
+
+    detail::Vertices kept;
+    kept.reserve(nextVertex);
+    for (VertexID v = 0; v < vertices.size(); v++)
+    {
+        if (not out.vertices[v].has_value())
+        {
+            continue;
+        }
+
+        detail::Vertex &vertex = kept.emplace_back(kept.size());
+        vertex.links.reserve(vertices[v].links.size());
+        for (detail::Link const &link : vertices[v].links)
+        {
+            detail::Link &moved = vertex.links.emplace_back(
+                *out.vertices[link.parentVertex],
+                *out.edges[static_cast<std::size_t>(link.parentEdge)]);
+
+            if (link.next.has_value())
+            {
+                auto const [nextV, nextE] = *link.next;
+                auto const toEdge = out.edges[static_cast<std::size_t>(nextE)];
+                if (toEdge.has_value())
+                {
+                    moved.next = {{*out.vertices[nextV], *toEdge}};
+                }
+            }
+        }
+    }
+
+    std::map<EdgeID, detail::Edge> renumbered;
+    std::vector<std::pair<VertexIDPair, EdgeID>> sorted;
+    sorted.reserve(edges.size());
+    for (auto const &[e, edge] : edges)
+    {
+        EdgeID const to = *out.edges[static_cast<std::size_t>(e)];
+        VertexIDPair const ends{*out.vertices[edge.ends.first], *out.vertices[edge.ends.second]};
+
+        renumbered.emplace_hint(renumbered.end(), to, detail::Edge{ends});
+        sorted.emplace_back(detail::orderedEnds(ends.first, ends.second), to);
+    }
+    ranges::sort(sorted);
+
+    vertices = std::move(kept);
+    edges = std::move(renumbered);
+    edgeIndex = detail::EdgeIndex(sorted.begin(), sorted.end());
+    lastEdgeID = nextEdge;
+
+    return out;
+}
+
 auto linkedToEdge(EdgeID const e)
 {
     return [e](detail::Link const l)
@@ -189,6 +351,15 @@ auto Topology::joinEdges(EdgeID fromEdge, EdgeID toEdge) -> MaybeChain
         return std::nullopt;
     }
 
+    if (batch)
+    {
+        batch->journal.push_back(
+            {.kind         = detail::Undo::Kind::JoinEdges,
+             .vertex       = v,
+             .whichLink    = static_cast<std::size_t>(fromLinkIt - links.begin()),
+             .previousNext = fromLinkIt->next});
+    }
+
     fromLinkIt->next = {{toLinkIt->parentVertex, toLinkIt->parentEdge}};
 
     return {Chain(v, fromLinkIt - links.begin())};
@@ -222,6 +393,10 @@ auto Topology::extendChain(Chain c, EdgeID nextEdge) -> bool
     return joinEdges(lastEdge, nextEdge).has_value();
 }
 
+/**
+ * Every adjacent Edge has a Link on the Vertex, so this is proportional to the
+ * number of adjacent Edges rather than to the size of the Topology.
+ */
 auto Topology::edgesAdjacentToVertex(VertexID v) const -> MaybeEdgeIDs
 {
     if (not hasVertex(v))
@@ -229,19 +404,25 @@ auto Topology::edgesAdjacentToVertex(VertexID v) const -> MaybeEdgeIDs
         return std::nullopt;
     }
 
-    auto vertexMatch =
-        [v](auto const &pair)
-        {
-            auto const &[key, e] = pair;
-            return (e.ends.first == v) || (e.ends.second == v);
-        };
+    auto view = linksAt(v) | views::transform(&detail::Link::parentEdge);
+    EdgeIDs out(view.begin(), view.end());
 
-    auto view =
-        this->edges
-        | views::filter(vertexMatch)
-        | views::keys;
+    // A loop Edge has two Links on the same Vertex
+    ranges::sort(out);
+    auto const rem = ranges::unique(out);
+    out.erase(rem.begin(), rem.end());
 
-    return EdgeIDs(view.begin(), view.end());
+    return out;
+}
+
+auto Topology::linksAt(VertexID v) const -> std::span<detail::Link const>
+{
+    if (not hasVertex(v))
+    {
+        return {};
+    }
+
+    return vertices.at(v).links;
 }
 
 auto Topology::getEdgeVertices(EdgeID edge) const -> MaybeVertexIDPair
@@ -333,6 +514,151 @@ auto Topology::getChainEdges(Chain chain) const -> MaybeEdgeIDs
     return out;
 }
 
+/**
+ * Edits are journaled in the order they are made, and rolled back in the
+ * reverse order. This way each undo step sees the Topology in exactly the state
+ * its edit left it in, e.g. the Links created by makeEdge are still the last
+ * ones on their Vertices.
+ *
+ * The Edge index is left alone for the duration of the batch: makeEdge finds
+ * duplicates using the Links on the Vertex instead, which are always up to
+ * date. On commit the deferred index changes are either merged in (small
+ * batches) or the index is rebuilt from scratch (large batches, e.g. imports).
+ */
+auto Topology::beginBatch() -> bool
+{
+    if (batch)
+    {
+        return false;
+    }
+
+    batch.emplace();
+    return true;
+}
+
+auto Topology::commit() -> bool
+{
+    if (not batch)
+    {
+        return false;
+    }
+
+    auto &[journal, added, removed] = *batch;
+
+    if (added.size() + removed.size() > edgeIndex.size() / 2)
+    {
+        std::vector<std::pair<VertexIDPair, EdgeID>> sorted;
+        sorted.reserve(edges.size());
+        for (auto const &[key, edge] : edges)
+        {
+            sorted.emplace_back(detail::orderedEnds(edge.ends.first, edge.ends.second), key);
+        }
+        ranges::sort(sorted);
+
+        // constructing from a sorted range is linear
+        edgeIndex = detail::EdgeIndex(sorted.begin(), sorted.end());
+    }
+    else
+    {
+        for (auto const &[key, edge] : removed)
+        {
+            auto const it = edgeIndex.find(key);
+            if (it != edgeIndex.end() && it->second == edge)
+            {
+                edgeIndex.erase(it);
+            }
+        }
+
+        ranges::sort(added);
+        auto hint = edgeIndex.begin();
+        for (auto const &[key, edge] : added)
+        {
+            // the Edge may have been deleted again later in the batch
+            if (hasEdge(edge))
+            {
+                hint = edgeIndex.emplace_hint(hint, key, edge);
+            }
+        }
+    }
+
+    batch.reset();
+    return true;
+}
+
+auto Topology::rollback() -> bool
+{
+    if (not batch)
+    {
+        return false;
+    }
+
+    for (auto const &u : batch->journal | views::reverse)
+    {
+        undo(u);
+    }
+
+    batch.reset();
+    return true;
+}
+
+auto Topology::inBatch() const -> bool
+{
+    return batch.has_value();
+}
+
+auto Topology::findEdge(VertexID v1, VertexID v2) const -> MaybeEdgeID
+{
+    if (not batch)
+    {
+        auto const it = edgeIndex.find(detail::orderedEnds(v1, v2));
+        return it == edgeIndex.end() ? std::nullopt : MaybeEdgeID(it->second);
+    }
+
+    for (auto const &link : vertices.at(v1).links)
+    {
+        if (oppositeVertex(v1, link.parentEdge) == v2)
+        {
+            return link.parentEdge;
+        }
+    }
+
+    return std::nullopt;
+}
+
+auto Topology::undo(detail::Undo const &u) -> void
+{
+    using Kind = detail::Undo::Kind;
+
+    switch (u.kind)
+    {
+        case Kind::AddVertex:
+            vertices.pop_back();
+            break;
+        case Kind::MakeEdge:
+            // makeEdge appended one Link to each end (two for a loop Edge)
+            edges.erase(u.edge);
+            vertices.at(u.ends.first).links.pop_back();
+            vertices.at(u.ends.second).links.pop_back();
+            lastEdgeID--;
+            break;
+        case Kind::JoinEdges:
+            vertices.at(u.vertex).links.at(u.whichLink).next = u.previousNext;
+            break;
+        case Kind::DeleteVertex:
+            vertices.at(u.vertex).index = u.vertex;
+            break;
+        case Kind::DeleteEdge:
+            edges.emplace(u.edge, detail::Edge{u.ends});
+            // removedLinks is in ascending position order for each Vertex
+            for (auto const &[v, position, link] : u.removedLinks)
+            {
+                auto &links = vertices.at(v).links;
+                links.insert(links.begin() + position, link);
+            }
+            break;
+    }
+}
+
 auto Topology::streamTo(std::ostream &os) const -> void
 {
     os << "lastVertexID = " << lastVertexID << ", "
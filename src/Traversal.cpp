@@ -0,0 +1,220 @@
+#include "mycad/Traversal.h"
+
+#include <algorithm>
+#include <functional> // std::greater
+
+using namespace mycad;
+namespace ranges = std::ranges;
+
+auto TraversalScratch::isVisited(VertexID v) const -> bool
+{
+    return v < reached.size() && reached.at(v) == epoch;
+}
+
+auto TraversalScratch::depth(VertexID v) const -> std::optional<std::size_t>
+{
+    if (not isVisited(v))
+    {
+        return std::nullopt;
+    }
+
+    return depths.at(v);
+}
+
+auto TraversalScratch::order() const -> std::span<VertexID const>
+{
+    return visitOrder;
+}
+
+/**
+ * The epoch only wraps around after 2³² traversals, at which point (and only
+ * then) the stamps really do need to be cleared.
+ */
+auto TraversalScratch::start(std::size_t nVertices) -> void
+{
+    epoch++;
+    if (epoch == 0)
+    {
+        ranges::fill(reached, 0);
+        ranges::fill(settled, 0);
+        epoch = 1;
+    }
+
+    if (reached.size() < nVertices)
+    {
+        reached.resize(nVertices, 0);
+        settled.resize(nVertices, 0);
+        depths.resize(nVertices);
+        distances.resize(nVertices);
+        parents.resize(nVertices);
+    }
+
+    visitOrder.clear();
+    heap.clear();
+}
+
+auto TraversalScratch::reach(VertexID v, std::pair<VertexID, EdgeID> via,
+                             std::size_t depth) -> bool
+{
+    if (reached.at(v) == epoch)
+    {
+        return false;
+    }
+
+    reached.at(v) = epoch;
+    parents.at(v) = via;
+    depths.at(v)  = depth;
+    visitOrder.push_back(v);
+
+    return true;
+}
+
+auto TraversalScratch::pathTo(VertexID from, VertexID to) const -> EdgeIDs
+{
+    EdgeIDs out{};
+    out.reserve(depths.at(to));
+
+    for (VertexID v = to; v != from; v = parents.at(v).first)
+    {
+        out.push_back(parents.at(v).second);
+    }
+
+    ranges::reverse(out);
+    return out;
+}
+
+auto mycad::breadthFirst(Topology const &topo, VertexID start,
+                         TraversalScratch &scratch, std::size_t maxDepth)
+    -> std::span<VertexID const>
+{
+    scratch.start(topo.vertexCount());
+
+    if (not topo.hasVertex(start))
+    {
+        return {};
+    }
+
+    scratch.reach(start, {start, 0}, 0);
+
+    // visitOrder is the queue: everything before `next` has been expanded
+    for (std::size_t next = 0; next < scratch.visitOrder.size(); next++)
+    {
+        VertexID const v = scratch.visitOrder.at(next);
+        std::size_t const depth = scratch.depths.at(v);
+
+        if (depth == maxDepth)
+        {
+            continue;
+        }
+
+        for (auto const &link : topo.linksAt(v))
+        {
+            auto const opp = topo.oppositeVertex(v, link.parentEdge);
+            scratch.reach(*opp, {v, link.parentEdge}, depth + 1);
+        }
+    }
+
+    return scratch.order();
+}
+
+auto mycad::ringNeighbourhood(Topology const &topo, VertexID v,
+                              std::size_t rings, TraversalScratch &scratch)
+    -> std::span<VertexID const>
+{
+    return breadthFirst(topo, v, scratch, rings);
+}
+
+auto mycad::shortestPath(Topology const &topo, VertexID from, VertexID to,
+                         TraversalScratch &scratch) -> MaybeEdgeIDs
+{
+    scratch.start(topo.vertexCount());
+
+    if (not (topo.hasVertex(from) && topo.hasVertex(to)))
+    {
+        return std::nullopt;
+    }
+
+    scratch.reach(from, {from, 0}, 0);
+
+    for (std::size_t next = 0; next < scratch.visitOrder.size(); next++)
+    {
+        VertexID const v = scratch.visitOrder.at(next);
+
+        if (v == to)
+        {
+            return scratch.pathTo(from, to);
+        }
+
+        for (auto const &link : topo.linksAt(v))
+        {
+            auto const opp = topo.oppositeVertex(v, link.parentEdge);
+            scratch.reach(*opp, {v, link.parentEdge}, scratch.depths.at(v) + 1);
+        }
+    }
+
+    return std::nullopt;
+}
+
+/**
+ * This is Dijkstra's algorithm with a binary heap. Rather than decreasing the
+ * key of a Vertex already in the heap, it is pushed again and the stale entry
+ * is skipped when it's popped.
+ */
+auto mycad::weightedShortestPath(Topology const &topo,
+                                 VertexID from, VertexID to,
+                                 TraversalScratch &scratch,
+                                 EdgeWeight const &weight) -> MaybeEdgeIDs
+{
+    scratch.start(topo.vertexCount());
+
+    if (not (topo.hasVertex(from) && topo.hasVertex(to)))
+    {
+        return std::nullopt;
+    }
+
+    auto &heap = scratch.heap;
+    auto const later = std::greater<>();
+
+    scratch.reach(from, {from, 0}, 0);
+    scratch.distances.at(from) = 0;
+    heap.emplace_back(0, from);
+
+    while (not heap.empty())
+    {
+        ranges::pop_heap(heap, later);
+        auto const [distance, v] = heap.back();
+        heap.pop_back();
+
+        if (scratch.settled.at(v) == scratch.epoch)
+        {
+            continue;
+        }
+        scratch.settled.at(v) = scratch.epoch;
+
+        if (v == to)
+        {
+            return scratch.pathTo(from, to);
+        }
+
+        for (auto const &link : topo.linksAt(v))
+        {
+            VertexID const opp = *topo.oppositeVertex(v, link.parentEdge);
+            float const candidate = distance + weight(link.parentEdge);
+
+            bool const isNew = scratch.reach(opp, {v, link.parentEdge},
+                                             scratch.depths.at(v) + 1);
+
+            if (isNew || candidate < scratch.distances.at(opp))
+            {
+                scratch.parents.at(opp)   = {v, link.parentEdge};
+                scratch.depths.at(opp)    = scratch.depths.at(v) + 1;
+                scratch.distances.at(opp) = candidate;
+
+                heap.emplace_back(candidate, opp);
+                ranges::push_heap(heap, later);
+            }
+        }
+    }
+
+    return std::nullopt;
+}
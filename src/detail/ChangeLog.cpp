@@ -0,0 +1,71 @@
+#include "mycad/detail/ChangeLog.h"
+
+#include <algorithm>
+
+using namespace mycad;
+
+auto detail::ChangeLog::add(Generation generation) -> void
+{
+    stamps.push_back(generation);
+    entries.push_back({generation, stamps.size() - 1});
+}
+
+auto detail::ChangeLog::touch(std::size_t id, Generation generation) -> void
+{
+    if (stamps.at(id) == generation)
+    {
+        return;
+    }
+
+    stamps.at(id) = generation;
+    entries.push_back({generation, id});
+
+    if (entries.size() > 2 * stamps.size() + 64)
+    {
+        compact();
+    }
+}
+
+auto detail::ChangeLog::truncate(std::size_t n) -> void
+{
+    if (n >= stamps.size())
+    {
+        return;
+    }
+
+    stamps.resize(n);
+    std::erase_if(entries, [n](Entry const &entry){return entry.id >= n;});
+}
+
+auto detail::ChangeLog::size() const -> std::size_t
+{
+    return stamps.size();
+}
+
+auto detail::ChangeLog::since(Generation generation) const -> std::vector<std::size_t>
+{
+    auto const first = std::ranges::upper_bound(entries, generation, {}, &Entry::generation);
+
+    std::vector<std::size_t> out;
+    for (auto entry = first; entry != entries.end(); entry++)
+    {
+        if (stamps[entry->id] == entry->generation)
+        {
+            out.push_back(entry->id);
+        }
+    }
+
+    return out;
+}
+
+/**
+ * Only the latest entry for each ID is ever reported, so the rest can go. What
+ * is left is still in Generation order.
+ */
+auto detail::ChangeLog::compact() -> void
+{
+    std::erase_if(entries, [this](Entry const &entry)
+    {
+        return stamps[entry.id] != entry.generation;
+    });
+}
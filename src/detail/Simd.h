@@ -0,0 +1,102 @@
+#ifndef MYCAD_SIMD_DETAIL_HEADER
+#define MYCAD_SIMD_DETAIL_HEADER
+
+// A thin wrapper around the widest vector of floats the target supports, so
+// that bulk kernels can be written once and compiled for AVX, SSE2 or plain
+// scalar code. AVX is only used when the compiler is allowed to emit it, e.g.
+// with MYCAD_NATIVE_ARCH.
+//
+// This is an implementation detail of the mycad libraries and is not
+// installed.
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace mycad::detail::simd
+{
+#if defined(__AVX__)
+    std::size_t constexpr width = 8;
+
+    struct Floats { __m256 v; };
+    struct Mask   { __m256 v; };
+
+    inline auto broadcast(float x) -> Floats { return {_mm256_set1_ps(x)}; }
+    inline auto load(float const *p) -> Floats { return {_mm256_loadu_ps(p)}; }
+    inline auto store(float *p, Floats a) -> void { _mm256_storeu_ps(p, a.v); }
+
+    inline auto operator+(Floats a, Floats b) -> Floats { return {_mm256_add_ps(a.v, b.v)}; }
+    inline auto operator-(Floats a, Floats b) -> Floats { return {_mm256_sub_ps(a.v, b.v)}; }
+    inline auto operator*(Floats a, Floats b) -> Floats { return {_mm256_mul_ps(a.v, b.v)}; }
+    inline auto operator/(Floats a, Floats b) -> Floats { return {_mm256_div_ps(a.v, b.v)}; }
+
+    // These follow the SSE semantics: the second argument is returned if
+    // either one is NaN
+    inline auto min(Floats a, Floats b) -> Floats { return {_mm256_min_ps(a.v, b.v)}; }
+    inline auto max(Floats a, Floats b) -> Floats { return {_mm256_max_ps(a.v, b.v)}; }
+    inline auto sqrt(Floats a) -> Floats { return {_mm256_sqrt_ps(a.v)}; }
+
+    inline auto operator==(Floats a, Floats b) -> Mask { return {_mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ)}; }
+    inline auto operator<(Floats a, Floats b) -> Mask { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+    inline auto operator>(Floats a, Floats b) -> Mask { return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)}; }
+
+    /** @returns @param a where @param m is set, @param b elsewhere */
+    inline auto select(Mask m, Floats a, Floats b) -> Floats { return {_mm256_blendv_ps(b.v, a.v, m.v)}; }
+#elif defined(__SSE2__)
+    std::size_t constexpr width = 4;
+
+    struct Floats { __m128 v; };
+    struct Mask   { __m128 v; };
+
+    inline auto broadcast(float x) -> Floats { return {_mm_set1_ps(x)}; }
+    inline auto load(float const *p) -> Floats { return {_mm_loadu_ps(p)}; }
+    inline auto store(float *p, Floats a) -> void { _mm_storeu_ps(p, a.v); }
+
+    inline auto operator+(Floats a, Floats b) -> Floats { return {_mm_add_ps(a.v, b.v)}; }
+    inline auto operator-(Floats a, Floats b) -> Floats { return {_mm_sub_ps(a.v, b.v)}; }
+    inline auto operator*(Floats a, Floats b) -> Floats { return {_mm_mul_ps(a.v, b.v)}; }
+    inline auto operator/(Floats a, Floats b) -> Floats { return {_mm_div_ps(a.v, b.v)}; }
+
+    inline auto min(Floats a, Floats b) -> Floats { return {_mm_min_ps(a.v, b.v)}; }
+    inline auto max(Floats a, Floats b) -> Floats { return {_mm_max_ps(a.v, b.v)}; }
+    inline auto sqrt(Floats a) -> Floats { return {_mm_sqrt_ps(a.v)}; }
+
+    inline auto operator==(Floats a, Floats b) -> Mask { return {_mm_cmpeq_ps(a.v, b.v)}; }
+    inline auto operator<(Floats a, Floats b) -> Mask { return {_mm_cmplt_ps(a.v, b.v)}; }
+    inline auto operator>(Floats a, Floats b) -> Mask { return {_mm_cmpgt_ps(a.v, b.v)}; }
+
+    inline auto select(Mask m, Floats a, Floats b) -> Floats
+    {
+        return {_mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v))};
+    }
+#else
+    std::size_t constexpr width = 1;
+
+    struct Floats { float v; };
+    struct Mask   { bool v; };
+
+    inline auto broadcast(float x) -> Floats { return {x}; }
+    inline auto load(float const *p) -> Floats { return {*p}; }
+    inline auto store(float *p, Floats a) -> void { *p = a.v; }
+
+    inline auto operator+(Floats a, Floats b) -> Floats { return {a.v + b.v}; }
+    inline auto operator-(Floats a, Floats b) -> Floats { return {a.v - b.v}; }
+    inline auto operator*(Floats a, Floats b) -> Floats { return {a.v * b.v}; }
+    inline auto operator/(Floats a, Floats b) -> Floats { return {a.v / b.v}; }
+
+    inline auto min(Floats a, Floats b) -> Floats { return {a.v < b.v ? a.v : b.v}; }
+    inline auto max(Floats a, Floats b) -> Floats { return {a.v > b.v ? a.v : b.v}; }
+    inline auto sqrt(Floats a) -> Floats { return {std::sqrt(a.v)}; }
+
+    inline auto operator==(Floats a, Floats b) -> Mask { return {a.v == b.v}; }
+    inline auto operator<(Floats a, Floats b) -> Mask { return {a.v < b.v}; }
+    inline auto operator>(Floats a, Floats b) -> Mask { return {a.v > b.v}; }
+
+    inline auto select(Mask m, Floats a, Floats b) -> Floats { return {m.v ? a.v : b.v}; }
+#endif
+} // namespace mycad::detail::simd
+
+#endif // MYCAD_SIMD_DETAIL_HEADER
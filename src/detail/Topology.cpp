@@ -41,6 +41,11 @@ auto detail::getCommonVertexID(EdgeID const eid1, EdgeID const eid2,
     }
 }
 
+auto detail::orderedEnds(VertexID const v1, VertexID const v2) -> VertexIDPair
+{
+    return std::minmax(v1, v2);
+}
+
 auto detail::linkedToEdge(EdgeID const e)
 {
     return [e](detail::Link const l)
@@ -1,6 +1,45 @@
 #include "mycad/render_helpers.h"
 
 #include <algorithm>
+#include <span>
+#include <thread>
+
+namespace
+{
+    std::size_t constexpr verticesPerSegment = 4;
+    std::size_t constexpr indicesPerSegment  = 6;
+
+    // Below this many Edges a thread costs more to start than it saves, so
+    // the default thread count never goes lower per thread
+    std::size_t constexpr minEdgesPerThread = 8192;
+
+    auto toVec3(mycad::Point const & p) -> glm::vec3
+    {
+        return {p.x, p.y, p.z};
+    }
+
+    // Runs fn(0) ... fn(n - 1), each on its own thread
+    template <typename F>
+    void inParallel(std::size_t n, F const & fn)
+    {
+        if (n == 1)
+        {
+            fn(0);
+            return;
+        }
+
+        std::vector<std::thread> workers;
+        workers.reserve(n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            workers.emplace_back(fn, i);
+        }
+        for (auto & worker : workers)
+        {
+            worker.join();
+        }
+    }
+}
 
 Mesh::Mesh(Fragment const & frag)
 {
@@ -122,3 +161,85 @@ std::size_t LineMesh::addVertex(LineVertex const & vertex)
     indices.push_back(index);
     return index;
 }
+
+/**
+ * Deleted Edges leave gaps in the Entity's Lines, so the segments can't be
+ * placed by EdgeID alone. Instead each chunk counts its live Edges, a prefix
+ * sum of the counts gives every chunk the segment it starts at, and then each
+ * chunk writes its vertices and indices (offset by that start) into its own
+ * slice of the buffers. Both passes run in parallel.
+ */
+auto makeLineMesh(mycad::Entity const & entity, unsigned threads)
+    -> std::optional<LineMesh>
+{
+    std::size_t const segments = entity.edges().size();
+    if (segments == 0)
+    {
+        return std::nullopt;
+    }
+
+    std::span<mycad::Line const> const lines = entity.getLines();
+
+    if (threads == 0)
+    {
+        std::size_t const most = std::max<std::size_t>(1, lines.size() / minEdgesPerThread);
+        threads = static_cast<unsigned>(std::min<std::size_t>(
+            std::max(1u, std::thread::hardware_concurrency()), most));
+    }
+    std::size_t const chunks = std::min<std::size_t>(threads, lines.size());
+
+    auto const chunkStart = [&](std::size_t c){return c * lines.size() / chunks;};
+
+    std::vector<std::size_t> firstSegment(chunks + 1, 0);
+    inParallel(chunks, [&](std::size_t c)
+    {
+        std::size_t count = 0;
+        for (std::size_t e = chunkStart(c); e < chunkStart(c + 1); e++)
+        {
+            count += entity.hasEdge(static_cast<mycad::EdgeID>(e)) ? 1 : 0;
+        }
+        firstSegment[c + 1] = count;
+    });
+
+    for (std::size_t c = 0; c < chunks; c++)
+    {
+        firstSegment[c + 1] += firstSegment[c];
+    }
+
+    LineMesh mesh;
+    mesh.vertices.resize(verticesPerSegment * segments);
+    mesh.indices.resize(indicesPerSegment * segments);
+
+    inParallel(chunks, [&](std::size_t c)
+    {
+        std::size_t segment = firstSegment[c];
+        for (std::size_t e = chunkStart(c); e < chunkStart(c + 1); e++)
+        {
+            if (not entity.hasEdge(static_cast<mycad::EdgeID>(e)))
+            {
+                continue;
+            }
+
+            glm::vec3 const v0 = toVec3(lines[e].atU(0));
+            glm::vec3 const v1 = toVec3(lines[e].atU(1));
+            glm::vec3 const dir = glm::normalize(v1 - v0);
+
+            std::size_t const first = verticesPerSegment * segment;
+            LineVertex * const vertex = mesh.vertices.data() + first;
+            vertex[0] = {v0,  dir,  1};
+            vertex[1] = {v0,  dir, -1};
+            vertex[2] = {v1, -dir,  1};
+            vertex[3] = {v1, -dir, -1};
+
+            // the same two triangles as addSegment
+            auto const base = static_cast<uint32_t>(first);
+            uint32_t * const index = mesh.indices.data() + indicesPerSegment * segment;
+            index[0] = base;     index[1] = base + 1; index[2] = base + 2;
+            index[3] = base;     index[4] = base + 2; index[5] = base + 3;
+
+            segment++;
+        }
+    });
+
+    return mesh;
+}
@@ -16,29 +16,7 @@ int main()
     ent.addEdge(v2, v3);
     ent.addEdge(v3, v1);
 
-    auto edges = ent.getEdges();
-    auto getStartFinish = [](mycad::Line const & line) -> std::pair<glm::vec3, glm::vec3>
-    {
-        auto p0 = line.atU(0);
-        auto p1 = line.atU(1);
-
-        return {{p0.x, p0.y, p0.z}, {p1.x, p1.y, p1.z}};
-    };
-
-    auto [left, right] = getStartFinish(edges.front());
-
-    LineMesh lines{left, right};
-
-    for(auto const & edge : edges)
-    {
-        if (edge == edges.front())
-        {
-            continue;
-        }
-
-        auto [left, right] = getStartFinish(edge);
-        lines.addSegment(left, right);
-    }
+    LineMesh lines = makeLineMesh(ent).value();
 
     ApplicationData app;
 
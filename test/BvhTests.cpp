@@ -0,0 +1,260 @@
+#include "mycad/Bvh.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // A few hundred short Lines scattered over a 100x100 square, a little
+    // above and below z = 0
+    auto makeScatter(mycad::Point const &offset) -> mycad::Entity
+    {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> position(0, 100);
+        std::uniform_real_distribution<float> step(-3, 3);
+
+        mycad::Entity entity;
+        for (int i = 0; i < 500; i++)
+        {
+            float const x = position(rng) + offset.x;
+            float const y = position(rng) + offset.y;
+            float const z = step(rng) / 10 + offset.z;
+
+            auto v1 = entity.addVertex({x, y, z});
+            auto v2 = entity.addVertex({x + step(rng), y + step(rng), z});
+            entity.addEdge(v1, v2);
+        }
+        return entity;
+    }
+
+    auto distanceTo(mycad::Line const &line, mycad::Point const &p) -> float
+    {
+        mycad::Point const a = line.atU(0);
+        mycad::Point const b = line.atU(1);
+
+        float const dx = b.x - a.x, dy = b.y - a.y, dz = b.z - a.z;
+        float const u = std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy + (p.z - a.z) * dz) /
+                                   (dx * dx + dy * dy + dz * dz), 0.0f, 1.0f);
+
+        return std::hypot(a.x + u * dx - p.x, a.y + u * dy - p.y, a.z + u * dz - p.z);
+    }
+
+    // The distance from the nearest Edge in @param entity, the slow way
+    auto bruteForce(mycad::Entity const &entity, mycad::Point const &p) -> float
+    {
+        float best = std::numeric_limits<float>::infinity();
+        for (auto const &line : entity.getEdges())
+        {
+            best = std::min(best, distanceTo(line, p));
+        }
+        return best;
+    }
+
+    auto sorted(mycad::EdgeIDs edges) -> mycad::EdgeIDs
+    {
+        std::ranges::sort(edges);
+        return edges;
+    }
+}
+
+SCENARIO("015: Bounding-volume hierarchy", "[entity][bvh]")
+{
+    GIVEN("A Bvh over an empty Entity")
+    {
+        mycad::Bvh const bvh(mycad::Entity{});
+
+        THEN("Every query comes back empty")
+        {
+            REQUIRE(bvh.empty());
+            REQUIRE_FALSE(bvh.nearest({0, 0, 0}).has_value());
+            REQUIRE_FALSE(bvh.pick({{0, 0, 1}, {0, 0, -1}}, 1).has_value());
+            REQUIRE(bvh.select({{-1, -1, -1}, {1, 1, 1}}).empty());
+        }
+    }
+
+    GIVEN("Two Lines that cross, one above the other")
+    {
+        mycad::Entity entity;
+        auto v0 = entity.addVertex({-1, 0, 0});
+        auto v1 = entity.addVertex({1, 0, 0});
+        auto v2 = entity.addVertex({0, -1, 2});
+        auto v3 = entity.addVertex({0, 1, 2});
+        auto low  = entity.addEdge(v0, v1).value();
+        auto high = entity.addEdge(v2, v3).value();
+
+        mycad::Bvh const bvh(entity);
+
+        THEN("Picking finds whichever one the Ray reaches first")
+        {
+            REQUIRE(bvh.pick({{0, 0, 10}, {0, 0, -1}}, 0.1f)->edge == high);
+            REQUIRE(bvh.pick({{0, 0, -10}, {0, 0, 1}}, 0.1f)->edge == low);
+            REQUIRE(bvh.pick({{0.5f, 0, 10}, {0, 0, -1}}, 0.1f)->edge == low);
+            REQUIRE_FALSE(bvh.pick({{0, 0, 10}, {0, 0, 1}}, 0.1f).has_value());
+        }
+    }
+
+    GIVEN("Lines spaced further and further apart")
+    {
+        // The heuristic would split these off one at a time, making a tree
+        // hundreds of levels deep, so these are split at the median instead
+        mycad::Entity entity;
+        std::vector<mycad::EdgeID> edges;
+        std::vector<float> xs;
+        for (int i = 0; i < 300; i++)
+        {
+            float const x = std::pow(1.2f, static_cast<float>(i));
+            auto v1 = entity.addVertex({x, 0, 0});
+            auto v2 = entity.addVertex({x, 1, 0});
+            edges.push_back(entity.addEdge(v1, v2).value());
+            xs.push_back(x);
+        }
+
+        mycad::Bvh const bvh(entity);
+
+        THEN("Every query still finds every Line")
+        {
+            for (std::size_t i = 0; i < edges.size(); i++)
+            {
+                REQUIRE(bvh.nearest({xs[i], 0.5f, 0})->edge == edges[i]);
+                REQUIRE(bvh.pick({{xs[i], 0.5f, 1}, {0, 0, -1}}, 0)->edge == edges[i]);
+            }
+
+            mycad::BoundingBox const all{{0, -1, -1}, {xs.back(), 2, 1}};
+            REQUIRE(sorted(bvh.select(all, mycad::SelectMode::Window)) == sorted(edges));
+        }
+    }
+
+    GIVEN("A Bvh over a scatter of Lines")
+    {
+        mycad::Entity const entity = makeScatter({0, 0, 0});
+        mycad::Bvh bvh(entity);
+
+        REQUIRE(bvh.size() == 500);
+
+        THEN("The nearest Edge matches a brute-force search")
+        {
+            for (float x = -10; x < 110; x += 7.5f)
+            {
+                for (float y = -10; y < 110; y += 7.5f)
+                {
+                    mycad::Point const p{x, y, 1};
+                    auto const hit = bvh.nearest(p);
+
+                    REQUIRE(hit.has_value());
+                    REQUIRE(hit->distance == Approx(bruteForce(entity, p)));
+                    REQUIRE(distanceTo(entity.getLine(hit->edge).value(), p) ==
+                            Approx(hit->distance));
+                }
+            }
+        }
+
+        THEN("Nothing is found beyond the maximum distance")
+        {
+            REQUIRE_FALSE(bvh.nearest({500, 500, 0}, 10).has_value());
+            REQUIRE(bvh.nearest({500, 500, 0}).has_value());
+        }
+
+        THEN("Picking straight down finds Edges within the tolerance")
+        {
+            // Every Line is level, so a vertical Ray is exactly as far from
+            // each one as (x, y) is, measured at the Line's height
+            auto planarDistance = [&entity](float x, float y)
+            {
+                float best = std::numeric_limits<float>::infinity();
+                for (auto const &line : entity.getEdges())
+                {
+                    best = std::min(best, distanceTo(line, {x, y, line.atU(0).z}));
+                }
+                return best;
+            };
+
+            for (float x = 0; x < 100; x += 3.3f)
+            {
+                for (float y = 0; y < 100; y += 3.3f)
+                {
+                    auto const hit = bvh.pick({{x, y, 10}, {0, 0, -2}}, 0.5f);
+                    float const nearest = planarDistance(x, y);
+
+                    if (nearest < 0.49f)
+                    {
+                        REQUIRE(hit.has_value());
+                    }
+                    if (nearest > 0.51f)
+                    {
+                        REQUIRE_FALSE(hit.has_value());
+                    }
+                    if (hit.has_value())
+                    {
+                        REQUIRE(hit->distance <= 0.5f);
+                        REQUIRE(hit->along == Approx(10 - hit->point.z));
+                    }
+                }
+            }
+        }
+
+        THEN("Box selection matches testing every Line")
+        {
+            mycad::BoundingBox const box{{20, 30, -1}, {60, 45, 1}};
+
+            mycad::EdgeIDs window, crossing;
+            for (auto const e : entity.getTopology().edgeIDs())
+            {
+                mycad::Line const line = entity.getLine(e).value();
+                if (box.contains(line.atU(0)) && box.contains(line.atU(1)))
+                {
+                    window.push_back(e);
+                }
+                for (float u = 0; u <= 1; u += 1.0f / 64)
+                {
+                    if (box.contains(line.atU(u)))
+                    {
+                        crossing.push_back(e);
+                        break;
+                    }
+                }
+            }
+
+            REQUIRE_FALSE(window.empty());
+            REQUIRE(sorted(bvh.select(box, mycad::SelectMode::Window)) == sorted(window));
+
+            // Sampling can miss a Line that only clips a corner, so it's only
+            // a lower bound
+            auto const selected = sorted(bvh.select(box));
+            REQUIRE(selected.size() >= crossing.size());
+            REQUIRE(std::ranges::includes(selected, sorted(crossing)));
+        }
+
+        WHEN("The Bvh is refit to the same Edges somewhere else")
+        {
+            mycad::Entity const moved = makeScatter({1000, -50, 3});
+            REQUIRE(bvh.refit(moved));
+
+            THEN("Queries find the moved Lines")
+            {
+                for (float x = 990; x < 1110; x += 9.5f)
+                {
+                    mycad::Point const p{x, x - 1040, 2};
+                    auto const hit = bvh.nearest(p);
+
+                    REQUIRE(hit.has_value());
+                    REQUIRE(hit->distance == Approx(bruteForce(moved, p)));
+                }
+            }
+        }
+
+        WHEN("The Bvh is refit to an Entity without all of its Edges")
+        {
+            THEN("Nothing changes")
+            {
+                REQUIRE_FALSE(bvh.refit(mycad::Entity{}));
+                REQUIRE(bvh.nearest({50, 50, 0})->distance ==
+                        Approx(bruteForce(entity, {50, 50, 0})));
+            }
+        }
+    }
+}
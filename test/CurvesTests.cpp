@@ -0,0 +1,157 @@
+#include "mycad/Tessellator.h"
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace
+{
+    float constexpr pi = std::numbers::pi_v<float>;
+
+    // The furthest any point of @param arc gets from the polyline through
+    // @param points, checked at the middle of each segment
+    auto chordError(mycad::Arc const &arc, std::span<mycad::Point const> points) -> float
+    {
+        float worst = 0;
+        for (std::size_t i = 0; i + 1 < points.size(); i++)
+        {
+            float const x = (points[i].x + points[i + 1].x) / 2;
+            float const y = (points[i].y + points[i + 1].y) / 2;
+            worst = std::max(worst, arc.radius() - std::hypot(x, y));
+        }
+        return worst;
+    }
+}
+
+SCENARIO( "022: Arcs, Circles and tessellation", "[geometry][curves]" )
+{
+    GIVEN("A quarter Arc and a Circle")
+    {
+        auto const arc = mycad::makeArc({1, 1, 5}, 2, 0, pi / 2).value();
+        auto const circle = mycad::makeCircle({0, 0, 0}, 3).value();
+
+        THEN("They are parametrized from start to end")
+        {
+            REQUIRE(arc.atU(0) == mycad::Point{3, 1, 5});
+            REQUIRE(arc.atU(1).x == Approx(1));
+            REQUIRE(arc.atU(1).y == Approx(3));
+            REQUIRE(arc.length() == Approx(pi));
+            REQUIRE_FALSE(arc.closed());
+
+            REQUIRE(circle.atU(0) == mycad::Point{3, 0, 0});
+            REQUIRE(circle.atU(0.5f).x == Approx(-3));
+            REQUIRE(circle.length() == Approx(6 * pi));
+            REQUIRE(circle.asArc().closed());
+        }
+
+        THEN("Clockwise Arcs have a negative sweep")
+        {
+            auto const clockwise = mycad::makeArc({0, 0, 0}, 1, 0, -pi / 2).value();
+            REQUIRE(clockwise.atU(1).y == Approx(-1));
+        }
+    }
+
+    THEN("Curves need a positive radius and a sweep of at most a full turn")
+    {
+        REQUIRE_FALSE(mycad::makeCircle({0, 0, 0}, 0).has_value());
+        REQUIRE_FALSE(mycad::makeCircle({0, 0, 0}, -1).has_value());
+        REQUIRE_FALSE(mycad::makeArc({0, 0, 0}, 1, 0, 0).has_value());
+        REQUIRE_FALSE(mycad::makeArc({0, 0, 0}, 1, 0, 7).has_value());
+        REQUIRE_FALSE(mycad::makeArc({0, 0, 0}, std::nanf(""), 0, 1).has_value());
+        REQUIRE(mycad::makeArc({0, 0, 0}, 1, 0, -2 * pi).has_value());
+    }
+
+    THEN("Tighter tolerances and larger radii need more segments")
+    {
+        REQUIRE(mycad::segmentCount(10, pi, 0.1f) < mycad::segmentCount(10, pi, 0.01f));
+        REQUIRE(mycad::segmentCount(10, pi, 0.1f) < mycad::segmentCount(100, pi, 0.1f));
+        REQUIRE(mycad::segmentCount(1, 2 * pi, 100) == 3);
+        REQUIRE(mycad::segmentCount(1, 0.1f, 100) == 1);
+        REQUIRE(mycad::segmentCount(1, pi, 0) == 65536);
+    }
+
+    GIVEN("A Tessellator")
+    {
+        mycad::Tessellator tessellator(0.5f, 10);
+        auto const hole = mycad::makeCircle({0, 0, 0}, 4).value();
+
+        THEN("The tolerance is rounded down to a power of two")
+        {
+            REQUIRE(tessellator.tolerance() == 0.03125f);
+        }
+
+        THEN("Polylines are within the tolerance of their curve")
+        {
+            for (float sweep : {0.3f, pi / 2, pi, -1.5f * pi, 2 * pi})
+            {
+                auto const arc = mycad::makeArc({0, 0, 0}, 7, 0.25f, sweep).value();
+                auto const points = tessellator.profile(arc);
+
+                REQUIRE(chordError(arc, points) <= tessellator.tolerance());
+                REQUIRE(points.front() == arc.atU(0));
+            }
+
+            auto const loop = tessellator.profile(hole);
+            REQUIRE(loop.front() == loop.back());
+            REQUIRE(chordError(hole.asArc(), loop) <= tessellator.tolerance());
+        }
+
+        THEN("Curves of the same shape share one cached polyline")
+        {
+            std::vector<mycad::Point> out;
+            for (int i = 0; i < 1000; i++)
+            {
+                float const f = static_cast<float>(i);
+                tessellator.tessellate(mycad::makeCircle({f, 2 * f, 1}, 4).value(), out);
+            }
+
+            auto const profile = tessellator.profile(hole);
+            REQUIRE(tessellator.cacheSize() == 1);
+            REQUIRE(out.size() == 1000 * profile.size());
+            REQUIRE(out.at(profile.size()) == mycad::Point{1 + profile[0].x, 2 + profile[0].y, 1});
+        }
+
+        THEN("Zooming within a band reuses the cache, and beyond it doesn't")
+        {
+            auto const before = tessellator.profile(hole);
+
+            tessellator.setScale(12);
+            REQUIRE(tessellator.profile(hole).data() == before.data());
+            REQUIRE(tessellator.cacheSize() == 1);
+
+            tessellator.setScale(20);
+            auto const closer = tessellator.profile(hole);
+            REQUIRE(tessellator.cacheSize() == 2);
+            REQUIRE(closer.size() > before.size());
+
+            tessellator.clear();
+            REQUIRE(tessellator.cacheSize() == 0);
+        }
+
+        THEN("Only the current band and its neighbours stay cached")
+        {
+            // Zoom in a band at a time across a lot of different Arcs
+            float scale = 10;
+            for (int step = 0; step < 20; step++)
+            {
+                for (int i = 1; i <= 50; i++)
+                {
+                    tessellator.profile(mycad::makeCircle({0, 0, 0}, static_cast<float>(i)).value());
+                }
+                REQUIRE(tessellator.cacheSize() <= 2 * 50);
+
+                scale *= 2;
+                tessellator.setScale(scale);
+            }
+
+            // Coming back one band still finds the last one
+            tessellator.setScale(scale / 2);
+            REQUIRE(tessellator.cacheSize() == 50);
+
+            tessellator.setScale(10);
+            REQUIRE(tessellator.cacheSize() == 0);
+        }
+    }
+}
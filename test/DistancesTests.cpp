@@ -0,0 +1,150 @@
+#include "mycad/Distances.h"
+#include "mycad/PreparedLine.h"
+#include "Arbitrary.h"
+
+#include <catch2/catch.hpp>
+#include "rapidcheck/catch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace
+{
+    auto distance(mycad::Point const &a, mycad::Point const &b) -> float
+    {
+        return std::hypot(a.x - b.x, a.y - b.y, a.z - b.z);
+    }
+
+    // The closest distance between two Lines, found by trying lots of points
+    // on the first one
+    auto sampledDistance(mycad::Line const &a, mycad::Line const &b) -> float
+    {
+        mycad::PreparedLine const prepared(b);
+
+        float best = std::numeric_limits<float>::infinity();
+        for (int i = 0; i <= 1000; i++)
+        {
+            best = std::min(best, prepared.distance(a.atU(static_cast<float>(i) / 1000)));
+        }
+        return best;
+    }
+}
+
+SCENARIO( "019: Batched distances", "[geometry][distances]" )
+{
+    rc::prop("Lines come no closer than their closest approach",
+        [](mycad::Line const &a, mycad::Line const &b)
+        {
+            auto const approach = mycad::closestApproach(a, b);
+            RC_ASSERT(approach.u1 >= 0);
+            RC_ASSERT(approach.u1 <= 1);
+            RC_ASSERT(approach.u2 >= 0);
+            RC_ASSERT(approach.u2 <= 1);
+
+            float const found = distance(a.atU(approach.u1), b.atU(approach.u2));
+            float const scale = std::max({a.length(), b.length(), 1.0f});
+            RC_ASSERT(std::abs(found - approach.distance) <= 1e-4f * scale);
+            RC_ASSERT(approach.distance <= sampledDistance(a, b) + 1e-4f * scale);
+        }
+    );
+
+    GIVEN("Two Lines that cross, and two that are parallel")
+    {
+        auto const a = mycad::makeLine({0, 0, 0}, {4, 0, 0}).value();
+        auto const b = mycad::makeLine({1, -1, 3}, {1, 1, 3}).value();
+        auto const c = mycad::makeLine({2, 2, 0}, {8, 2, 0}).value();
+
+        THEN("Crossing Lines are closest where one passes over the other")
+        {
+            auto const approach = mycad::closestApproach(a, b);
+            REQUIRE(approach.u1 == 0.25f);
+            REQUIRE(approach.u2 == 0.5f);
+            REQUIRE(approach.distance == 3);
+        }
+
+        THEN("Parallel Lines are closest at the start of their overlap")
+        {
+            auto const approach = mycad::closestApproach(a, c);
+            REQUIRE(approach.u1 == 0.5f);
+            REQUIRE(approach.u2 == 0);
+            REQUIRE(approach.distance == 2);
+        }
+    }
+
+    GIVEN("A few hundred random Points and Lines")
+    {
+        // Not a whole number of vectors, so the last one is only partly used
+        std::size_t const n = 333;
+
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> position(-50, 50);
+        auto random = [&]() { return mycad::Point{position(rng), position(rng), position(rng)}; };
+
+        std::vector<mycad::Point> points, starts, ends;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            points.push_back(random());
+            starts.push_back(random());
+            ends.push_back(random());
+        }
+
+        mycad::PointArray const pointArray(points);
+        mycad::PointArray const startArray(starts);
+        mycad::PointArray const endArray(ends);
+
+        auto const line = mycad::makeLine({-10, 5, 0}, {20, -5, 10}).value();
+        mycad::PreparedLine const prepared(line);
+        mycad::Point const p{3, -7, 11};
+
+        std::vector<float> us(n), vs(n), distances(n);
+
+        THEN("The closest points on one Line match PreparedLine")
+        {
+            REQUIRE(mycad::closestPoints(line, pointArray, us, distances));
+            for (std::size_t i = 0; i < n; i++)
+            {
+                REQUIRE(us[i] == Approx(std::clamp(prepared.project(points[i]), 0.0f, 1.0f)).margin(1e-5));
+                REQUIRE(distances[i] == Approx(prepared.distance(points[i])));
+            }
+        }
+
+        THEN("The closest points on many Lines match PreparedLine")
+        {
+            REQUIRE(mycad::closestPoints(startArray, endArray, p, us, distances));
+            for (std::size_t i = 0; i < n; i++)
+            {
+                mycad::PreparedLine const other(mycad::makeLine(starts[i], ends[i]).value());
+                REQUIRE(us[i] == Approx(std::clamp(other.project(p), 0.0f, 1.0f)).margin(1e-5));
+                REQUIRE(distances[i] == Approx(other.distance(p)));
+            }
+        }
+
+        THEN("The closest approaches match closestApproach")
+        {
+            REQUIRE(mycad::closestApproaches(line, startArray, endArray, us, vs, distances));
+            for (std::size_t i = 0; i < n; i++)
+            {
+                auto const expected = mycad::closestApproach(mycad::makeLine(starts[i], ends[i]).value(), line);
+                REQUIRE(us[i] == Approx(expected.u1).margin(1e-5));
+                REQUIRE(vs[i] == Approx(expected.u2).margin(1e-5));
+                REQUIRE(distances[i] == Approx(expected.distance).margin(1e-5));
+            }
+        }
+
+        THEN("Nothing is written if the outputs are too small")
+        {
+            std::vector<float> tooSmall(n - 1, -1);
+            REQUIRE_FALSE(mycad::closestPoints(line, pointArray, tooSmall, distances));
+            REQUIRE_FALSE(mycad::closestPoints(startArray, pointArray, p, us, tooSmall));
+            REQUIRE_FALSE(mycad::closestApproaches(line, startArray, endArray, us, tooSmall, distances));
+            REQUIRE(std::ranges::count(tooSmall, -1.0f) == static_cast<std::ptrdiff_t>(n - 1));
+
+            mycad::PointArray const shorter{std::span(starts).first(n - 1)};
+            REQUIRE_FALSE(mycad::closestPoints(shorter, endArray, p, us, distances));
+        }
+    }
+}
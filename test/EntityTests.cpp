@@ -4,6 +4,9 @@
 #include <catch2/catch.hpp>
 #include "rapidcheck/catch.h"
 
+#include <algorithm>
+#include <limits>
+
 SCENARIO( "004: Vertex Entity", "[entity][vertex]" )
 {
     rc::prop("A Point can be recovered using a Vertex",
@@ -37,3 +40,1099 @@ SCENARIO( "004: Vertex Entity", "[entity][vertex]" )
         /* verbose= */ true
     );
 }
+
+SCENARIO( "006: Batched Entity edits", "[entity][batch]" )
+{
+    GIVEN("An Entity with a single Edge")
+    {
+        mycad::Entity entity;
+        auto v0 = entity.addVertex({0, 0, 0});
+        auto v1 = entity.addVertex({1, 0, 0});
+        auto e0 = entity.addEdge(v0, v1).value();
+
+        WHEN("A batch of edits is rolled back")
+        {
+            REQUIRE(entity.beginBatch());
+            auto v2 = entity.addVertex({1, 1, 0});
+            auto e1 = entity.addEdge(v1, v2).value();
+            REQUIRE(entity.rollback());
+
+            THEN("Only the original Edge remains")
+            {
+                REQUIRE(entity.getEdges().size() == 1);
+                REQUIRE(entity.getLine(e0).has_value());
+                REQUIRE_FALSE(entity.getLine(e1).has_value());
+            }
+
+            THEN("New Vertices and Edges can still be added")
+            {
+                auto v3 = entity.addVertex({2, 2, 0});
+                REQUIRE(entity.getPoint(v3) == mycad::Point{2, 2, 0});
+                REQUIRE(entity.addEdge(v1, v3).has_value());
+            }
+        }
+
+        WHEN("A batch of edits is committed")
+        {
+            REQUIRE(entity.beginBatch());
+            auto v2 = entity.addVertex({1, 1, 0});
+            entity.addEdge(v1, v2);
+            REQUIRE(entity.commit());
+
+            THEN("The edits are kept")
+            {
+                REQUIRE(entity.getEdges().size() == 2);
+                REQUIRE(entity.getPoint(v2) == mycad::Point{1, 1, 0});
+            }
+        }
+    }
+}
+
+SCENARIO( "009: Planar Faces", "[entity][faces]" )
+{
+    GIVEN("A square split in two by a diagonal, with a dangling Edge")
+    {
+        //  v3 ──── v2
+        //  │     ╱ │
+        //  │   ╱   │
+        //  │ ╱     │
+        //  v0 ──── v1 ──── v4
+        mycad::Entity entity;
+        auto v0 = entity.addVertex({0, 0, 0});
+        auto v1 = entity.addVertex({1, 0, 0});
+        auto v2 = entity.addVertex({1, 1, 0});
+        auto v3 = entity.addVertex({0, 1, 0});
+        auto v4 = entity.addVertex({2, 0, 0});
+
+        auto e01 = entity.addEdge(v0, v1).value();
+        auto e12 = entity.addEdge(v1, v2).value();
+        auto e23 = entity.addEdge(v2, v3).value();
+        auto e30 = entity.addEdge(v3, v0).value();
+        auto e02 = entity.addEdge(v0, v2).value();
+        auto e14 = entity.addEdge(v1, v4).value();
+
+        WHEN("The Faces are found")
+        {
+            mycad::Faces faces = entity.findFaces();
+
+            auto sortedEdges = [](mycad::Face const &face)
+            {
+                auto out = face.edges;
+                std::ranges::sort(out);
+                return out;
+            };
+
+            THEN("There are two bounded Faces and one outer boundary")
+            {
+                REQUIRE(faces.size() == 3);
+                REQUIRE(std::ranges::count_if(faces, [](auto const &f){return f.area > 0;}) == 2);
+            }
+
+            THEN("Each triangle is a bounded Face")
+            {
+                std::vector<mycad::EdgeIDs> bounded;
+                for (auto const &face : faces)
+                {
+                    if (face.area > 0)
+                    {
+                        CHECK(face.area == Approx(0.5));
+                        bounded.push_back(sortedEdges(face));
+                    }
+                }
+                std::ranges::sort(bounded);
+
+                REQUIRE(bounded == std::vector<mycad::EdgeIDs>{{e01, e12, e02},
+                                                               {e23, e30, e02}});
+            }
+
+            THEN("The outer boundary walks the dangling Edge in both directions")
+            {
+                auto outer = std::ranges::find_if(faces, [](auto const &f){return f.area < 0;});
+
+                REQUIRE(outer->area == Approx(-1));
+                REQUIRE(outer->edges.size() == 6);
+                REQUIRE(std::ranges::count(outer->edges, e14) == 2);
+            }
+
+            THEN("Consecutive Edges in a Face share a Vertex")
+            {
+                auto const &topo = entity.getTopology();
+                for (auto const &face : faces)
+                {
+                    for (std::size_t i = 0; i < face.edges.size(); i++)
+                    {
+                        auto const e = face.edges.at(i);
+                        auto const next = face.edges.at((i + 1) % face.edges.size());
+                        auto const [a, b] = *topo.getEdgeVertices(e);
+                        auto const [c, d] = *topo.getEdgeVertices(next);
+                        REQUIRE((a == c || a == d || b == c || b == d));
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO( "021: Chain geometry", "[entity][chain]" )
+{
+    GIVEN("A Chain of three Edges, the middle one drawn backwards")
+    {
+        //  v3 ◀─── v2
+        //          ▲
+        //          │
+        //  v0 ───▶ v1
+        mycad::Entity entity;
+        auto v0 = entity.addVertex({0, 0, 0});
+        auto v1 = entity.addVertex({3, 0, 0});
+        auto v2 = entity.addVertex({3, 4, 0});
+        auto v3 = entity.addVertex({0, 4, 0});
+
+        auto e01 = entity.addEdge(v0, v1).value();
+        auto e21 = entity.addEdge(v2, v1).value();
+        auto e23 = entity.addEdge(v2, v3).value();
+
+        auto chain = entity.joinEdges(e01, e21).value();
+        REQUIRE(entity.extendChain(chain, e23));
+
+        auto const geometry = entity.getChainGeometry(chain).value();
+
+        THEN("Its Edges and lengths are known")
+        {
+            REQUIRE(geometry.size() == 3);
+            REQUIRE(geometry.edges() == mycad::EdgeIDs{e01, e21, e23});
+            REQUIRE(geometry.length() == 10);
+            REQUIRE(geometry.lengthBefore(1) == 3);
+            REQUIRE(geometry.lengthBefore(3) == 10);
+        }
+
+        THEN("Its Points are listed in walking order")
+        {
+            REQUIRE(geometry.points() == std::vector<mycad::Point>{
+                {0, 0, 0}, {3, 0, 0}, {3, 4, 0}, {0, 4, 0}});
+        }
+
+        THEN("Points are found by the distance along it")
+        {
+            REQUIRE(geometry.atLength(0) == mycad::Point{0, 0, 0});
+            REQUIRE(geometry.atLength(1.5f) == mycad::Point{1.5f, 0, 0});
+            REQUIRE(geometry.atLength(3) == mycad::Point{3, 0, 0});
+            REQUIRE(geometry.atLength(5) == mycad::Point{3, 2, 0});
+            REQUIRE(geometry.atLength(8.5f) == mycad::Point{1.5f, 4, 0});
+            REQUIRE(geometry.atLength(10) == mycad::Point{0, 4, 0});
+        }
+
+        THEN("Distances off either end are clamped")
+        {
+            REQUIRE(geometry.atLength(-1) == mycad::Point{0, 0, 0});
+            REQUIRE(geometry.atLength(20) == mycad::Point{0, 4, 0});
+        }
+
+        THEN("Positions are given along each Edge's own Line")
+        {
+            auto const middle = geometry.locate(6);
+            REQUIRE(middle.edge == e21);
+            REQUIRE(middle.u == Approx(0.25));
+
+            auto const corner = geometry.locate(3);
+            REQUIRE(corner.edge == e21);
+            REQUIRE(corner.u == 1);
+            REQUIRE(entity.getLine(corner.edge)->atU(corner.u) == mycad::Point{3, 0, 0});
+        }
+
+        THEN("Batches of distances, sorted or not, match atLength")
+        {
+            std::vector<float> ss{-2, 0, 0.5f, 2.9f, 3, 3.1f, 7, 9.99f, 10, 12,
+                                  4, 1, 8, 6, 0};
+            std::vector<mycad::Point> out(ss.size());
+            REQUIRE(geometry.atLengths(ss, out));
+
+            for (std::size_t i = 0; i < ss.size(); i++)
+            {
+                REQUIRE(out.at(i) == geometry.atLength(ss.at(i)));
+            }
+
+            out.pop_back();
+            REQUIRE_FALSE(geometry.atLengths(ss, out));
+        }
+    }
+
+    GIVEN("A long Chain of short Edges")
+    {
+        mycad::Entity entity;
+        std::size_t const n = 2'000;
+
+        mycad::VertexID previous = entity.addVertex({0, 1, 0});
+        mycad::EdgeIDs edges;
+        for (std::size_t i = 1; i <= n; i++)
+        {
+            auto const next = entity.addVertex({static_cast<float>(i) / 10, 1, 0});
+            edges.push_back(entity.addEdge(previous, next).value());
+            previous = next;
+        }
+
+        auto chain = entity.joinEdges(edges.at(0), edges.at(1)).value();
+        for (std::size_t i = 2; i < n; i++)
+        {
+            entity.extendChain(chain, edges.at(i));
+        }
+
+        auto const geometry = entity.getChainGeometry(chain).value();
+
+        THEN("Distances stay accurate all the way along it")
+        {
+            REQUIRE(geometry.length() == Approx(200));
+            REQUIRE(geometry.atLength(123.45f).x == Approx(123.45f));
+            REQUIRE(geometry.atLength(199.95f).x == Approx(199.95f));
+        }
+    }
+
+    THEN("There is no geometry for a Chain that doesn't exist")
+    {
+        mycad::Entity entity;
+        auto v = entity.addVertex({0, 0, 0});
+        REQUIRE_FALSE(entity.getChainGeometry({v, 0}).has_value());
+        REQUIRE_FALSE(entity.getChainGeometry({v + 1, 0}).has_value());
+    }
+}
+
+SCENARIO( "024: Entity bounds", "[entity][bounds]" )
+{
+    GIVEN("An empty Entity")
+    {
+        mycad::Entity entity;
+
+        THEN("It has no bounds")
+        {
+            REQUIRE_FALSE(entity.bounds().has_value());
+            REQUIRE_FALSE(entity.getEdgeBounds(0).has_value());
+            REQUIRE_FALSE(entity.getChainBounds({0, 0}).has_value());
+        }
+    }
+
+    rc::prop("The bounds contain every Vertex, and touch the furthest ones",
+        [](std::vector<mycad::Point> const &points)
+        {
+            mycad::Entity entity;
+            for (auto const &p : points)
+            {
+                entity.addVertex(p);
+            }
+
+            auto const box = entity.bounds();
+            RC_ASSERT(box.has_value() == not points.empty());
+            if (box.has_value())
+            {
+                auto const lowestX = std::ranges::min(points, {}, &mycad::Point::x).x;
+                auto const highestZ = std::ranges::max(points, {}, &mycad::Point::z).z;
+                RC_ASSERT(box->min.x == lowestX);
+                RC_ASSERT(box->max.z == highestZ);
+                RC_ASSERT(std::ranges::all_of(points, [&](auto const &p){return box->contains(p);}));
+            }
+        });
+
+    GIVEN("A Chain of two Edges, and a Vertex off to one side")
+    {
+        mycad::Entity entity;
+        auto v0 = entity.addVertex({0, 0, 0});
+        auto v1 = entity.addVertex({2, 1, 0});
+        auto v2 = entity.addVertex({3, -1, 1});
+        entity.addVertex({-5, 10, 0});
+
+        auto e01 = entity.addEdge(v0, v1).value();
+        auto e12 = entity.addEdge(v1, v2).value();
+        auto chain = entity.joinEdges(e01, e12).value();
+
+        THEN("Each Edge and the Chain have their own boxes")
+        {
+            REQUIRE(entity.getEdgeBounds(e12) ==
+                    mycad::BoundingBox{{2, -1, 0}, {3, 1, 1}});
+            REQUIRE(entity.getChainBounds(chain) ==
+                    mycad::BoundingBox{{0, -1, 0}, {3, 1, 1}});
+            REQUIRE(entity.bounds() ==
+                    mycad::BoundingBox{{-5, -1, 0}, {3, 10, 1}});
+        }
+
+        WHEN("The Chain is extended")
+        {
+            auto v3 = entity.addVertex({4, 0, -2});
+            auto e23 = entity.addEdge(v2, v3).value();
+            REQUIRE(entity.extendChain(chain, e23));
+
+            THEN("Its box grows")
+            {
+                REQUIRE(entity.getChainBounds(chain) ==
+                        mycad::BoundingBox{{0, -1, -2}, {4, 1, 1}});
+            }
+        }
+
+        WHEN("A batch that grows everything is rolled back")
+        {
+            auto const before = entity.bounds();
+            auto const chainBefore = entity.getChainBounds(chain);
+
+            REQUIRE(entity.beginBatch());
+            auto v3 = entity.addVertex({100, 100, 100});
+            auto e23 = entity.addEdge(v2, v3).value();
+            REQUIRE(entity.extendChain(chain, e23));
+            auto v4 = entity.addVertex({-100, 0, 0});
+            auto e04 = entity.addEdge(v0, v4).value();
+            auto other = entity.joinEdges(e04, e01).value();
+            REQUIRE(entity.getChainBounds(other).has_value());
+            REQUIRE(entity.rollback());
+
+            THEN("The boxes shrink back again")
+            {
+                REQUIRE(entity.bounds() == before);
+                REQUIRE(entity.getChainBounds(chain) == chainBefore);
+                REQUIRE_FALSE(entity.getChainBounds(other).has_value());
+            }
+        }
+    }
+
+    GIVEN("A path of three Edges whose last one rises to y = 50")
+    {
+        mycad::Entity entity;
+        auto v0 = entity.addVertex({0, 0, 0});
+        auto v1 = entity.addVertex({1, 0, 0});
+        auto v2 = entity.addVertex({2, 0, 0});
+        auto v3 = entity.addVertex({3, 50, 0});
+
+        auto e1 = entity.addEdge(v0, v1).value();
+        auto e2 = entity.addEdge(v1, v2).value();
+        auto e3 = entity.addEdge(v2, v3).value();
+
+        mycad::BoundingBox const whole{{0, 0, 0}, {3, 50, 0}};
+
+        WHEN("The end is joined before the start")
+        {
+            REQUIRE(entity.joinEdges(e2, e3).has_value());
+            auto chain = entity.joinEdges(e1, e2).value();
+
+            THEN("The Chain's box covers all three Edges")
+            {
+                REQUIRE(entity.getTopology().getChainEdges(chain)->size() == 3);
+                REQUIRE(entity.getChainBounds(chain) == whole);
+            }
+        }
+
+        WHEN("The start is joined before the end")
+        {
+            auto chain = entity.joinEdges(e1, e2).value();
+            REQUIRE(entity.getChainBounds(chain)->max.y == 0);
+            REQUIRE(entity.joinEdges(e2, e3).has_value());
+
+            THEN("The Chain's box grows to take in the last Edge")
+            {
+                REQUIRE(entity.getTopology().getChainEdges(chain)->size() == 3);
+                REQUIRE(entity.getChainBounds(chain) == whole);
+            }
+        }
+    }
+
+    GIVEN("A Chain extended from the start of its last Edge rather than the end")
+    {
+        mycad::Entity entity;
+        auto a = entity.addVertex({0, 0, 0});
+        auto b = entity.addVertex({1, 0, 0});
+        auto c = entity.addVertex({2, 0, 0});
+        auto d = entity.addVertex({1, 50, 0});
+
+        auto ab = entity.addEdge(a, b).value();
+        auto bc = entity.addEdge(b, c).value();
+        auto bd = entity.addEdge(b, d).value();
+        auto chain = entity.joinEdges(ab, bc).value();
+        REQUIRE(entity.getChainBounds(chain).has_value());
+
+        // The Topology joins bc to bd at b, which the Chain has already passed
+        REQUIRE(entity.extendChain(chain, bd));
+
+        THEN("The Chain and its box are unchanged")
+        {
+            REQUIRE(entity.getTopology().getChainEdges(chain)->size() == 2);
+            REQUIRE(entity.getChainBounds(chain) ==
+                    mycad::BoundingBox{{0, 0, 0}, {2, 0, 0}});
+        }
+    }
+}
+
+SCENARIO( "025: Edge views", "[entity][edge]" )
+{
+    GIVEN("An Entity with a few Edges")
+    {
+        mycad::Entity entity;
+        auto v0 = entity.addVertex({0, 0, 0});
+        auto v1 = entity.addVertex({1, 0, 0});
+        auto v2 = entity.addVertex({1, 1, 0});
+
+        auto e01 = entity.addEdge(v0, v1).value();
+        auto e12 = entity.addEdge(v1, v2).value();
+        auto e20 = entity.addEdge(v2, v0).value();
+
+        THEN("The view visits every Edge with its Line, in EdgeID order")
+        {
+            auto const edges = entity.edges();
+            REQUIRE(edges.size() == 3);
+
+            std::vector<mycad::EdgeID> ids;
+            for (auto const [id, line] : edges)
+            {
+                ids.push_back(id);
+                REQUIRE(line == entity.getLine(id).value());
+            }
+            REQUIRE(ids == std::vector<mycad::EdgeID>{e01, e12, e20});
+        }
+
+        THEN("It reads the same Lines as getEdges, without copying them")
+        {
+            auto const copies = entity.getEdges();
+            auto const lines = entity.getLines();
+            REQUIRE(std::ranges::equal(copies, lines));
+            REQUIRE(&(*entity.edges().begin()).line == &lines[0]);
+        }
+
+        WHEN("A batch that adds an Edge is rolled back")
+        {
+            REQUIRE(entity.beginBatch());
+            auto v3 = entity.addVertex({5, 5, 5});
+            entity.addEdge(v2, v3);
+            REQUIRE(entity.edges().size() == 4);
+            REQUIRE(entity.rollback());
+
+            THEN("The view no longer sees it")
+            {
+                REQUIRE(entity.edges().size() == 3);
+                REQUIRE(std::ranges::distance(entity.edges()) == 3);
+            }
+        }
+    }
+
+    THEN("An empty Entity has an empty view")
+    {
+        mycad::Entity entity;
+        REQUIRE(entity.edges().empty());
+        REQUIRE(entity.edges().begin() == entity.edges().end());
+    }
+}
+
+SCENARIO( "026: Moving Vertices", "[entity][vertex]" )
+{
+    GIVEN("A triangle, walked as a Chain, and a separate Edge")
+    {
+        mycad::Entity entity;
+        auto v0 = entity.addVertex({0, 0, 0});
+        auto v1 = entity.addVertex({4, 0, 0});
+        auto v2 = entity.addVertex({0, 4, 0});
+        auto v3 = entity.addVertex({-1, -1, 0});
+        auto v4 = entity.addVertex({-1, -2, 0});
+
+        auto e01 = entity.addEdge(v0, v1).value();
+        auto e12 = entity.addEdge(v1, v2).value();
+        auto e20 = entity.addEdge(v2, v0).value();
+        auto e34 = entity.addEdge(v3, v4).value();
+
+        auto chain = entity.joinEdges(e01, e12).value();
+        REQUIRE(entity.extendChain(chain, e20));
+        REQUIRE(entity.getChainBounds(chain) ==
+                mycad::BoundingBox{{0, 0, 0}, {4, 4, 0}});
+
+        auto const before = entity.generation();
+
+        WHEN("A Vertex is moved")
+        {
+            REQUIRE(entity.moveVertex(v1, {2, 0, 1}));
+
+            THEN("The Lines that meet there follow it, and nothing else changes")
+            {
+                REQUIRE(entity.getPoint(v1) == mycad::Point{2, 0, 1});
+                REQUIRE(entity.getLine(e01)->atU(1) == mycad::Point{2, 0, 1});
+                REQUIRE(entity.getLine(e12)->atU(0) == mycad::Point{2, 0, 1});
+                REQUIRE(entity.getLine(e20)->atU(0) == mycad::Point{0, 4, 0});
+                REQUIRE(entity.getLine(e34)->atU(0) == mycad::Point{-1, -1, 0});
+            }
+
+            THEN("Only it and those Lines have changed")
+            {
+                auto changes = entity.changesSince(before);
+                std::ranges::sort(changes.edges);
+                REQUIRE(changes.vertices == std::vector<mycad::VertexID>{v1});
+                REQUIRE(changes.edges == mycad::EdgeIDs{e01, e12});
+            }
+
+            THEN("The boxes shrink to fit")
+            {
+                REQUIRE(entity.bounds() ==
+                        mycad::BoundingBox{{-1, -2, 0}, {2, 4, 1}});
+                REQUIRE(entity.getChainBounds(chain) ==
+                        mycad::BoundingBox{{0, 0, 0}, {2, 4, 1}});
+            }
+        }
+
+        WHEN("Two Vertices at either end of an Edge are moved together")
+        {
+            std::vector<mycad::VertexMove> const moves{{v0, {1, 1, 1}}, {v1, {5, 1, 1}}};
+            REQUIRE(entity.moveVertices(moves));
+
+            THEN("The Edge between them uses both new Points")
+            {
+                REQUIRE(entity.getLine(e01)->atU(0) == mycad::Point{1, 1, 1});
+                REQUIRE(entity.getLine(e01)->atU(1) == mycad::Point{5, 1, 1});
+                REQUIRE(entity.getLine(e20)->atU(1) == mycad::Point{1, 1, 1});
+                REQUIRE(entity.changesSince(before).edges.size() == 3);
+            }
+        }
+
+        WHEN("A move would shrink a Line to a point")
+        {
+            std::vector<mycad::VertexMove> const moves{{v2, {0, 3, 0}}, {v1, {0, 0, 0}}};
+
+            THEN("None of the moves are made")
+            {
+                REQUIRE_FALSE(entity.moveVertices(moves));
+                REQUIRE_FALSE(entity.moveVertex(v4, {-1, -1, 0}));
+                REQUIRE_FALSE(entity.moveVertex(99, {0, 0, 0}));
+
+                REQUIRE(entity.getPoint(v2) == mycad::Point{0, 4, 0});
+                REQUIRE(entity.getPoint(v1) == mycad::Point{4, 0, 0});
+                REQUIRE(entity.getLine(e12)->atU(1) == mycad::Point{0, 4, 0});
+                REQUIRE(entity.generation() == before);
+            }
+        }
+
+        WHEN("Moves made in a batch are rolled back")
+        {
+            REQUIRE(entity.beginBatch());
+            REQUIRE(entity.moveVertex(v1, {10, 10, 10}));
+            REQUIRE(entity.moveVertex(v1, {20, 20, 20}));
+            auto v5 = entity.addVertex({30, 30, 30});
+            REQUIRE(entity.addEdge(v1, v5).has_value());
+            REQUIRE(entity.rollback());
+
+            THEN("Everything is back where it was")
+            {
+                REQUIRE(entity.getPoint(v1) == mycad::Point{4, 0, 0});
+                REQUIRE(entity.getLine(e01)->atU(1) == mycad::Point{4, 0, 0});
+                REQUIRE(entity.getLine(e12)->atU(0) == mycad::Point{4, 0, 0});
+                REQUIRE(entity.bounds() ==
+                        mycad::BoundingBox{{-1, -2, 0}, {4, 4, 0}});
+                REQUIRE(entity.getChainBounds(chain) ==
+                        mycad::BoundingBox{{0, 0, 0}, {4, 4, 0}});
+            }
+        }
+    }
+}
+
+SCENARIO( "027: Entity generations", "[entity][changes]" )
+{
+    GIVEN("An Entity with a couple of Edges")
+    {
+        mycad::Entity entity;
+        auto v0 = entity.addVertex({0, 0, 0});
+        auto v1 = entity.addVertex({1, 0, 0});
+        auto v2 = entity.addVertex({1, 1, 0});
+        auto e01 = entity.addEdge(v0, v1).value();
+        auto e12 = entity.addEdge(v1, v2).value();
+
+        THEN("Everything has changed since the start")
+        {
+            auto const changes = entity.changesSince(0);
+            REQUIRE(changes.generation == entity.generation());
+            REQUIRE(changes.vertices == std::vector<mycad::VertexID>{v0, v1, v2});
+            REQUIRE(changes.edges == mycad::EdgeIDs{e01, e12});
+            REQUIRE(changes.vertexCount == 3);
+            REQUIRE(changes.edgeCount == 2);
+        }
+
+        THEN("Nothing has changed since now")
+        {
+            auto const changes = entity.changesSince(entity.generation());
+            REQUIRE(changes.vertices.empty());
+            REQUIRE(changes.edges.empty());
+        }
+
+        WHEN("The same Vertex is moved many times, and an Edge is added")
+        {
+            auto const seen = entity.generation();
+            for (int i = 0; i < 1000; i++)
+            {
+                REQUIRE(entity.moveVertex(v2, {2, static_cast<float>(i + 2), 0}));
+            }
+            auto v3 = entity.addVertex({5, 5, 5});
+            auto e23 = entity.addEdge(v2, v3).value();
+
+            THEN("Each is listed once, in the order they last changed")
+            {
+                auto const changes = entity.changesSince(seen);
+                REQUIRE(changes.generation > seen);
+                REQUIRE(changes.vertices == std::vector<mycad::VertexID>{v2, v3});
+                REQUIRE(changes.edges == mycad::EdgeIDs{e12, e23});
+            }
+        }
+
+        WHEN("A batch is rolled back")
+        {
+            auto const seen = entity.generation();
+
+            REQUIRE(entity.beginBatch());
+            REQUIRE(entity.moveVertex(v0, {-1, 0, 0}));
+            auto v3 = entity.addVertex({5, 5, 5});
+            entity.addEdge(v2, v3);
+            REQUIRE(entity.rollback());
+
+            THEN("What was put back has changed, and what was removed is gone")
+            {
+                auto const changes = entity.changesSince(seen);
+                REQUIRE(changes.vertices == std::vector<mycad::VertexID>{v0});
+                REQUIRE(changes.edges == mycad::EdgeIDs{e01});
+                REQUIRE(changes.vertexCount == 3);
+                REQUIRE(changes.edgeCount == 2);
+            }
+        }
+    }
+}
+
+SCENARIO( "028: Welding Vertices", "[entity][weld]" )
+{
+    GIVEN("A triangle imported as three separate Lines, with some noise")
+    {
+        mycad::Entity entity;
+        auto addLine = [&entity](mycad::Point const &a, mycad::Point const &b)
+        {
+            auto v1 = entity.addVertex(a);
+            auto v2 = entity.addVertex(b);
+            return entity.addEdge(v1, v2).value();
+        };
+
+        auto e0 = addLine({0, 0, 0}, {1, 0, 0});
+        auto e1 = addLine({1.0001f, 0, 0}, {0, 1, 0});
+        auto e2 = addLine({0, 0.9999f, 0}, {0, 0.0001f, 0});
+
+        // a sliver shorter than the tolerance, and a copy of the first Line
+        auto sliver = addLine({5, 5, 5}, {5, 5, 5.0001f});
+        auto copy = addLine({0.0001f, 0, 0}, {1, 0.0001f, 0});
+
+        WHEN("It is welded")
+        {
+            auto const result = entity.weld(0.001f);
+
+            THEN("Coincident Vertices are merged into the first of them")
+            {
+                REQUIRE(result.vertices == std::vector<mycad::VertexID>{
+                    0, 1, 1, 3, 3, 0, 6, 6, 0, 1});
+            }
+
+            THEN("The triangle is connected, and the sliver and copy are gone")
+            {
+                REQUIRE(entity.edges().size() == 3);
+                REQUIRE(entity.getLine(e0).has_value());
+                REQUIRE_FALSE(entity.getLine(sliver).has_value());
+                REQUIRE_FALSE(entity.getLine(copy).has_value());
+
+                auto const &topo = entity.getTopology();
+                for (mycad::VertexID v : {0u, 1u, 3u})
+                {
+                    REQUIRE(topo.linksAt(v).size() == 2);
+                }
+                REQUIRE(topo.linksAt(2).empty());
+            }
+
+            THEN("Every rewired Edge is reported")
+            {
+                REQUIRE(result.edges.size() == 4);
+                REQUIRE(result.edges[0].first == e1);
+                REQUIRE(result.edges[1].first == e2);
+                REQUIRE(result.edges[2] == std::pair{sliver, mycad::MaybeEdgeID{}});
+                REQUIRE(result.edges[3] == std::pair{copy, mycad::MaybeEdgeID{}});
+
+                auto const newE1 = result.edges[0].second.value();
+                REQUIRE(entity.getLine(newE1)->atU(0) == mycad::Point{1, 0, 0});
+                REQUIRE(entity.getLine(newE1)->atU(1) == mycad::Point{0, 1, 0});
+            }
+
+            THEN("It makes a closed Face")
+            {
+                auto const faces = entity.findFaces();
+                REQUIRE(faces.size() == 2);
+            }
+        }
+
+        WHEN("Welding is rolled back")
+        {
+            REQUIRE(entity.beginBatch());
+            entity.weld(0.001f);
+            REQUIRE(entity.rollback());
+
+            THEN("The Lines are separate again")
+            {
+                REQUIRE(entity.edges().size() == 5);
+                REQUIRE(entity.getLine(e1).has_value());
+                REQUIRE(entity.getLine(sliver).has_value());
+                REQUIRE(entity.getTopology().linksAt(1).size() == 1);
+            }
+        }
+
+        WHEN("The tolerance is too small to merge anything")
+        {
+            auto const result = entity.weld(0);
+
+            THEN("Nothing changes")
+            {
+                REQUIRE(result.edges.empty());
+                REQUIRE(entity.edges().size() == 5);
+            }
+        }
+
+        WHEN("The tolerance is NaN")
+        {
+            auto const result = entity.weld(std::numeric_limits<float>::quiet_NaN());
+
+            THEN("It's treated as zero and nothing changes")
+            {
+                REQUIRE(result.edges.empty());
+                REQUIRE(entity.edges().size() == 5);
+            }
+        }
+    }
+
+    GIVEN("A large grid of Lines that each have their own Vertices")
+    {
+        mycad::Entity entity;
+        int constexpr n = 100;
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                auto const x = static_cast<float>(i);
+                auto const y = static_cast<float>(j);
+                auto a = entity.addVertex({x, y, 0});
+                auto b = entity.addVertex({x + 1, y, 0});
+                auto c = entity.addVertex({x, y, 0});
+                auto d = entity.addVertex({x, y + 1, 0});
+                entity.addEdge(a, b);
+                entity.addEdge(c, d);
+            }
+        }
+
+        THEN("Welding joins it into one piece")
+        {
+            auto const result = entity.weld(0.01f);
+            std::size_t kept = 0;
+            for (mycad::VertexID v = 0; v < result.vertices.size(); v++)
+            {
+                kept += result.vertices[v] == v ? 1 : 0;
+            }
+
+            REQUIRE(kept == (n + 1) * (n + 1) - 1);
+            REQUIRE(entity.edges().size() == 2 * n * n);
+        }
+    }
+
+    GIVEN("The same sort of grid at site coordinates, welded at a millimetre")
+    {
+        // Far enough out that there are millions of tolerance-sized cells
+        // between the drawing and the origin
+        mycad::Entity entity;
+        int constexpr n = 100;
+        float constexpr offset = 5000;
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                auto const x = offset + static_cast<float>(i);
+                auto const y = offset + static_cast<float>(j);
+                auto a = entity.addVertex({x, y, offset});
+                auto b = entity.addVertex({x + 1, y, offset});
+                auto c = entity.addVertex({x, y, offset});
+                auto d = entity.addVertex({x, y + 1, offset});
+                entity.addEdge(a, b);
+                entity.addEdge(c, d);
+            }
+        }
+
+        THEN("Welding joins it into one piece, just as near the origin")
+        {
+            auto const result = entity.weld(1e-3f);
+            std::size_t kept = 0;
+            for (mycad::VertexID v = 0; v < result.vertices.size(); v++)
+            {
+                kept += result.vertices[v] == v ? 1 : 0;
+            }
+
+            REQUIRE(kept == (n + 1) * (n + 1) - 1);
+            REQUIRE(entity.edges().size() == 2 * n * n);
+        }
+    }
+}
+
+SCENARIO( "030: Removing Edges and Vertices", "[entity][remove]" )
+{
+    GIVEN("A square with a diagonal")
+    {
+        mycad::Entity entity;
+        auto v0 = entity.addVertex({0, 0, 0});
+        auto v1 = entity.addVertex({1, 0, 0});
+        auto v2 = entity.addVertex({1, 1, 0});
+        auto v3 = entity.addVertex({0, 1, 0});
+        auto v4 = entity.addVertex({9, 9, 9});
+
+        auto e01 = entity.addEdge(v0, v1).value();
+        auto e12 = entity.addEdge(v1, v2).value();
+        auto e23 = entity.addEdge(v2, v3).value();
+        REQUIRE(entity.addEdge(v3, v0).has_value());
+        auto e02 = entity.addEdge(v0, v2).value();
+        auto e24 = entity.addEdge(v2, v4).value();
+
+        auto chain = entity.joinEdges(e01, e12).value();
+
+        WHEN("An Edge is removed")
+        {
+            auto const seen = entity.generation();
+            REQUIRE(entity.removeEdge(e02));
+
+            THEN("It is gone from the Entity and the Topology, and reported")
+            {
+                REQUIRE_FALSE(entity.hasEdge(e02));
+                REQUIRE_FALSE(entity.getLine(e02).has_value());
+                REQUIRE_FALSE(entity.getTopology().hasEdge(e02));
+                REQUIRE(entity.edges().size() == 5);
+                REQUIRE(entity.changesSince(seen).edges == mycad::EdgeIDs{e02});
+                REQUIRE_FALSE(entity.removeEdge(e02));
+            }
+
+            THEN("The Faces no longer see it")
+            {
+                REQUIRE(entity.findFaces().size() == 2);
+            }
+
+            THEN("New Edges still get new IDs")
+            {
+                REQUIRE(entity.addEdge(v0, v2).value() > e24);
+            }
+        }
+
+        WHEN("A Vertex is removed")
+        {
+            auto const seen = entity.generation();
+            REQUIRE(entity.removeVertex(v4));
+
+            THEN("Its Edges go with it, and the bounds shrink")
+            {
+                REQUIRE_FALSE(entity.hasVertex(v4));
+                REQUIRE_FALSE(entity.hasEdge(e24));
+                REQUIRE(entity.edges().size() == 5);
+                REQUIRE(entity.bounds() ==
+                        mycad::BoundingBox{{0, 0, 0}, {1, 1, 0}});
+                REQUIRE_THROWS(entity.getPoint(v4));
+                REQUIRE_FALSE(entity.moveVertex(v4, {0, 0, 0}));
+                REQUIRE_FALSE(entity.addEdge(v4, v0).has_value());
+            }
+
+            THEN("The removed Vertex and Edge are reported as changed")
+            {
+                auto const changes = entity.changesSince(seen);
+                REQUIRE(changes.vertices == std::vector<mycad::VertexID>{v4});
+                REQUIRE(changes.edges == mycad::EdgeIDs{e24});
+            }
+        }
+
+        WHEN("A Vertex on the Chain is removed")
+        {
+            REQUIRE(entity.getChainBounds(chain).has_value());
+            REQUIRE(entity.removeVertex(v1));
+
+            THEN("The Chain is gone")
+            {
+                REQUIRE_FALSE(entity.hasEdge(e01));
+                REQUIRE_FALSE(entity.hasEdge(e12));
+                REQUIRE_FALSE(entity.getChainBounds(chain).has_value());
+                REQUIRE(entity.edges().size() == 4);
+            }
+        }
+
+        WHEN("Removals are rolled back")
+        {
+            auto const before = entity.getEdges();
+
+            REQUIRE(entity.beginBatch());
+            REQUIRE(entity.removeEdge(e23));
+            REQUIRE(entity.removeVertex(v4));
+            REQUIRE(entity.rollback());
+
+            THEN("Everything is back")
+            {
+                REQUIRE(entity.hasVertex(v4));
+                REQUIRE(entity.hasEdge(e23));
+                REQUIRE(entity.hasEdge(e24));
+                REQUIRE(entity.getEdges() == before);
+                REQUIRE(entity.bounds() ==
+                        mycad::BoundingBox{{0, 0, 0}, {9, 9, 9}});
+                REQUIRE(entity.getTopology().linksAt(v4).size() == 1);
+            }
+        }
+
+        WHEN("Removals are compacted away")
+        {
+            REQUIRE(entity.removeEdge(e02));
+            REQUIRE(entity.removeVertex(v4));
+            auto const seen = entity.generation();
+            auto const remap = entity.compact().value();
+
+            THEN("Only what's left takes up room, under its new IDs")
+            {
+                REQUIRE(remap.vertices[v4] == std::nullopt);
+                REQUIRE(remap.edges[static_cast<std::size_t>(e02)] == std::nullopt);
+                REQUIRE(entity.getLines().size() == 4);
+                REQUIRE(entity.edges().size() == 4);
+                REQUIRE(entity.getTopology().vertexCount() == 4);
+
+                auto const newE23 = remap.edges[static_cast<std::size_t>(e23)].value();
+                auto const newV2 = remap.vertices[v2].value();
+                REQUIRE(entity.getPoint(newV2) == mycad::Point{1, 1, 0});
+                REQUIRE(entity.getLine(newE23)->atU(1) == mycad::Point{0, 1, 0});
+                REQUIRE(entity.bounds() == mycad::BoundingBox{{0, 0, 0}, {1, 1, 0}});
+            }
+
+            THEN("The Chain keeps its box under its Vertex's new ID")
+            {
+                mycad::Chain const moved{remap.vertices[chain.whichVertex].value(), chain.whichLink};
+                REQUIRE(entity.getChainBounds(moved) ==
+                        mycad::BoundingBox{{0, 0, 0}, {1, 1, 0}});
+            }
+
+            THEN("Everything is reported as changed")
+            {
+                auto const changes = entity.changesSince(seen);
+                REQUIRE(changes.vertices.size() == 4);
+                REQUIRE(changes.edges.size() == 4);
+                REQUIRE(changes.vertexCount == 4);
+            }
+
+            THEN("It can't be done during a batch")
+            {
+                REQUIRE(entity.beginBatch());
+                REQUIRE_FALSE(entity.compact().has_value());
+                REQUIRE(entity.rollback());
+            }
+        }
+
+        WHEN("Edges are added and removed over and over, compacting as it goes")
+        {
+            std::size_t mostSlots = 0;
+            for (int round = 0; round < 50; round++)
+            {
+                std::vector<mycad::VertexID> added;
+                for (int i = 0; i < 100; i++)
+                {
+                    auto a = entity.addVertex({static_cast<float>(i), -1, 0});
+                    entity.addEdge(a, v0);
+                    added.push_back(a);
+                }
+                for (auto const a : added)
+                {
+                    REQUIRE(entity.removeVertex(a));
+                }
+
+                if (2 * entity.edges().size() < entity.getLines().size())
+                {
+                    REQUIRE(entity.compact().has_value());
+                }
+                mostSlots = std::max(mostSlots, entity.getLines().size());
+            }
+
+            THEN("The storage, and so the cost of a scan, stays flat")
+            {
+                REQUIRE(entity.getLines().size() == 6);
+                REQUIRE(entity.getTopology().vertexCount() == 5);
+                REQUIRE(mostSlots <= 6);
+                REQUIRE(entity.bounds() ==
+                        mycad::BoundingBox{{0, 0, 0}, {9, 9, 9}});
+            }
+        }
+
+        WHEN("Many Edges are added and removed")
+        {
+            for (int i = 0; i < 1000; i++)
+            {
+                auto a = entity.addVertex({static_cast<float>(i), -1, 0});
+                auto e = entity.addEdge(a, v0).value();
+                REQUIRE(entity.removeEdge(e));
+                REQUIRE(entity.removeVertex(a));
+            }
+
+            THEN("Only the original Edges are left")
+            {
+                REQUIRE(entity.edges().size() == 6);
+                REQUIRE(entity.getTopology().linksAt(v0).size() == 3);
+                REQUIRE(entity.bounds() ==
+                        mycad::BoundingBox{{0, 0, 0}, {9, 9, 9}});
+            }
+        }
+    }
+
+    GIVEN("A Chain whose Vertex has an older, unrelated Edge")
+    {
+        mycad::Entity entity;
+        auto a = entity.addVertex({0, 0, 0});
+        auto b = entity.addVertex({1, 0, 0});
+        auto c = entity.addVertex({2, 0, 0});
+        auto d = entity.addVertex({1, 5, 0});
+
+        auto other = entity.addEdge(b, d).value();
+        auto e1 = entity.addEdge(a, b).value();
+        auto e2 = entity.addEdge(b, c).value();
+
+        auto chain = entity.joinEdges(e1, e2).value();
+        REQUIRE(entity.getChainBounds(chain) ==
+                mycad::BoundingBox{{0, 0, 0}, {2, 0, 0}});
+
+        WHEN("The unrelated Edge is removed")
+        {
+            REQUIRE(entity.removeEdge(other));
+
+            THEN("The Chain's bounds agree with the Topology")
+            {
+                auto const chainEdges = entity.getTopology().getChainEdges(chain);
+                bool const exists = chainEdges.has_value() && not chainEdges->empty();
+
+                REQUIRE(entity.getChainGeometry(chain).has_value() == exists);
+                REQUIRE(entity.getChainBounds(chain).has_value() == exists);
+            }
+
+            THEN("The Chain keeps its box under its new Link, and can be extended")
+            {
+                mycad::Chain const moved{b, chain.whichLink - 1};
+                REQUIRE(entity.getTopology().getChainEdges(moved) == mycad::EdgeIDs{e1, e2});
+                REQUIRE(entity.getChainBounds(moved) ==
+                        mycad::BoundingBox{{0, 0, 0}, {2, 0, 0}});
+
+                auto far = entity.addVertex({3, 0, 0});
+                REQUIRE(entity.extendChain(moved, entity.addEdge(c, far).value()));
+                REQUIRE(entity.getChainBounds(moved) ==
+                        mycad::BoundingBox{{0, 0, 0}, {3, 0, 0}});
+            }
+        }
+
+        WHEN("A Chain starting part way along it is extended")
+        {
+            auto v3 = entity.addVertex({3, 0, 0});
+            auto e3 = entity.addEdge(c, v3).value();
+            REQUIRE(entity.extendChain(chain, e3));
+
+            // e2 now leads on to e3 from c, so a Chain starts there too
+            auto const &links = entity.getTopology().linksAt(c);
+            auto const at = std::ranges::find_if(links, [&](auto const &link){return link.parentEdge == e2;});
+            mycad::Chain const tail{c, static_cast<std::size_t>(at - links.begin())};
+            REQUIRE(entity.getTopology().getChainEdges(tail) == mycad::EdgeIDs{e2, e3});
+
+            auto v4 = entity.addVertex({3, 7, 0});
+            REQUIRE(entity.extendChain(tail, entity.addEdge(v3, v4).value()));
+
+            THEN("Both it and the Chain it's part of have grown")
+            {
+                REQUIRE(entity.getChainBounds(tail) ==
+                        mycad::BoundingBox{{1, 0, 0}, {3, 7, 0}});
+                REQUIRE(entity.getChainBounds(chain) ==
+                        mycad::BoundingBox{{0, 0, 0}, {3, 7, 0}});
+            }
+        }
+    }
+}
@@ -4,6 +4,9 @@
 #include <catch2/catch.hpp>
 #include "rapidcheck/catch.h"
 
+#include <cmath>
+#include <vector>
+
 SCENARIO( "001: Line Geometry", "[geometry][line]" )
 {
     rc::prop("A line cannot be constructed with only one point",
@@ -72,4 +75,135 @@ SCENARIO( "001: Line Geometry", "[geometry][line]" )
         },
         /* verbose= */ true
     );
+
+    rc::prop("atU matches std::lerp",
+        [](mycad::Line const &line)
+        {
+            float const u = *rc::gen::arbitrary<float>();
+            mycad::Point const p1 = line.atU(0);
+            mycad::Point const p2 = line.atU(1);
+
+            mycad::Point const expected{std::lerp(p1.x, p2.x, u),
+                                        std::lerp(p1.y, p2.y, u),
+                                        std::lerp(p1.z, p2.z, u)};
+            RC_ASSERT(line.atU(u) == expected);
+        }
+    );
+
+    GIVEN("Lines made at compile time")
+    {
+        constexpr auto line = mycad::makeLine({0, 0, 0}, {2, 4, -6});
+
+        static_assert(line.has_value());
+        static_assert(line->atU(0.5f) == mycad::Point{1, 2, -3});
+        static_assert(line->atU(1) == mycad::Point{2, 4, -6});
+        static_assert(not mycad::makeLine({1, 1, 1}, {1, 1, 1}).has_value());
+
+        THEN("They are the same as Lines made at run time")
+        {
+            mycad::Point const p2{2, 4, -6};
+            REQUIRE(line == mycad::makeLine({0, 0, 0}, p2));
+        }
+    }
+}
+
+SCENARIO( "011: Batched Line sampling", "[geometry][line]" )
+{
+    rc::prop("Sampling many parameters at once matches atU",
+        [](mycad::Line const &line)
+        {
+            // enough to cover the vectorized part and the left-overs
+            std::vector<float> us{0, 1, 0.5f, 0.25f, -1, 2, 1e-7f, 0.9999999f,
+                                  0, 0.1f, 0.3f, 1, 1.5f, -0.5f, 0.7f, 0.6f, 1};
+            us.push_back(*rc::gen::arbitrary<float>());
+
+            std::vector<mycad::Point> out(us.size());
+            RC_ASSERT(line.sampleU(us, out));
+
+            for (std::size_t i = 0; i < us.size(); i++)
+            {
+                mycad::Point const expected = line.atU(us.at(i));
+                if (us.at(i) == 0 || us.at(i) == 1)
+                {
+                    RC_ASSERT(out.at(i) == expected);
+                }
+                else
+                {
+                    // the compiler may fuse the multiply-adds in atU
+                    RC_ASSERT(out.at(i).x == Approx(expected.x).margin(1e-3));
+                    RC_ASSERT(out.at(i).y == Approx(expected.y).margin(1e-3));
+                    RC_ASSERT(out.at(i).z == Approx(expected.z).margin(1e-3));
+                }
+            }
+        },
+        /* verbose= */ true
+    );
+
+    rc::prop("Uniform samples run exactly from one end of the Line to the other",
+        [](mycad::Line const &line)
+        {
+            std::size_t const n = *rc::gen::inRange<std::size_t>(2, 100);
+            std::vector<mycad::Point> out(n);
+            line.sampleUniform(out);
+
+            RC_ASSERT(out.front() == line.atU(0));
+            RC_ASSERT(out.back() == line.atU(1));
+        },
+        /* verbose= */ true
+    );
+
+    GIVEN("A Line")
+    {
+        mycad::Line line = mycad::makeLine({0, 0, 0}, {1, 2, 3}).value();
+
+        THEN("Samples can't be written to a buffer that is too small")
+        {
+            std::vector<float> us{0, 0.5, 1};
+            std::vector<mycad::Point> out(2);
+            REQUIRE_FALSE(line.sampleU(us, out));
+        }
+
+        THEN("A single uniform sample is the start of the Line")
+        {
+            std::vector<mycad::Point> out(1);
+            line.sampleUniform(out);
+            REQUIRE(out.front() == line.atU(0));
+        }
+    }
+}
+
+SCENARIO( "020: Double-precision Lines", "[geometry][line]" )
+{
+    GIVEN("A Line far from the origin, which float can't resolve")
+    {
+        REQUIRE(static_cast<float>(1e8 + 0.25) == static_cast<float>(1e8));
+
+        auto const line = mycad::makeLine<double>({1e8, 0, 0}, {1e8 + 1, 2, 0}).value();
+
+        THEN("It keeps the detail")
+        {
+            REQUIRE(line.atU(0.25) == mycad::PointD{1e8 + 0.25, 0.5, 0});
+            REQUIRE(line.length() == Approx(std::sqrt(5.0)));
+            REQUIRE(line.intersects({1e8 + 0.25, 0.5, 0}));
+            REQUIRE_FALSE(line.intersects({1e8 + 0.25, 0.75, 0}));
+        }
+
+        THEN("It can be sampled in bulk")
+        {
+            std::vector<double> us{0, 0.25, 0.5, 1};
+            std::vector<mycad::PointD> out(us.size());
+            REQUIRE(line.sampleU(us, out));
+            REQUIRE(out.at(1) == line.atU(0.25));
+
+            std::vector<mycad::PointD> uniform(5);
+            line.sampleUniform(uniform);
+            REQUIRE(uniform.at(1) == line.atU(0.25));
+            REQUIRE(uniform.back() == line.atU(1));
+        }
+    }
+
+    THEN("A double-precision Line still needs two different Points")
+    {
+        REQUIRE_FALSE(mycad::makeLine<double>({1, 2, 3}, {1, 2, 3}).has_value());
+    }
 }
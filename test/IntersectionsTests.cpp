@@ -0,0 +1,159 @@
+#include "mycad/Intersections.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    auto addLine(mycad::Entity &entity, mycad::Point const &p1, mycad::Point const &p2)
+        -> mycad::EdgeID
+    {
+        auto v1 = entity.addVertex(p1);
+        auto v2 = entity.addVertex(p2);
+        return entity.addEdge(v1, v2).value();
+    }
+
+    // Counts the Edges that properly cross by testing every pair, which is
+    // all there are for Lines in general position
+    auto bruteForceCrossings(mycad::Entity const &entity) -> std::size_t
+    {
+        auto const lines = entity.getEdges();
+        auto side = [](mycad::Point const &a, mycad::Point const &b, mycad::Point const &c)
+        {
+            double const d = (double(b.x) - a.x) * (double(c.y) - a.y) -
+                             (double(b.y) - a.y) * (double(c.x) - a.x);
+            return (d > 0) - (d < 0);
+        };
+
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < lines.size(); i++)
+        {
+            for (std::size_t j = i + 1; j < lines.size(); j++)
+            {
+                auto const a = lines[i].atU(0), b = lines[i].atU(1);
+                auto const c = lines[j].atU(0), d = lines[j].atU(1);
+
+                if (side(a, b, c) * side(a, b, d) < 0 && side(c, d, a) * side(c, d, b) < 0)
+                {
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+}
+
+SCENARIO("017: Edge intersections", "[entity][intersections]")
+{
+    GIVEN("A grid of crossing Lines, like a hash sign")
+    {
+        mycad::Entity entity;
+        for (int i = 0; i < 10; i++)
+        {
+            float const f = static_cast<float>(i);
+            addLine(entity, {f, -1, 0}, {f, 10, 0});
+            addLine(entity, {-1, f + 0.5f, 0}, {10, f + 0.5f, 0});
+        }
+
+        THEN("Every horizontal Line crosses every vertical one")
+        {
+            auto const found = mycad::findIntersections(entity);
+            REQUIRE(found.size() == 100);
+
+            for (auto const &x : found)
+            {
+                REQUIRE(x.first < x.second);
+                REQUIRE_FALSE(x.overlapping);
+
+                auto const p = entity.getLine(x.first)->atU(x.u1);
+                auto const q = entity.getLine(x.second)->atU(x.u2);
+                REQUIRE(p.x == Approx(q.x).margin(1e-5));
+                REQUIRE(p.y == Approx(q.y).margin(1e-5));
+            }
+        }
+    }
+
+    GIVEN("Lines that touch, overlap or share a Vertex")
+    {
+        mycad::Entity entity;
+
+        // A T-junction: the stem ends on the bar
+        auto bar  = addLine(entity, {0, 0, 0}, {4, 0, 0});
+        auto stem = addLine(entity, {1, 0, 0}, {1, 3, 0});
+
+        // Two collinear Lines that overlap from x = 7 to x = 8
+        auto left  = addLine(entity, {6, 0, 0}, {8, 0, 0});
+        auto right = addLine(entity, {9, 0, 0}, {7, 0, 0});
+
+        // An L made of two Edges meeting at a shared Vertex
+        auto corner = entity.addVertex({0, 10, 0});
+        auto up     = entity.addEdge(entity.addVertex({0, 5, 0}), corner).value();
+        auto across = entity.addEdge(corner, entity.addVertex({5, 10, 0})).value();
+
+        // Two Lines that cross in the XY plane, at different heights
+        auto low  = addLine(entity, {10, 5, 0}, {12, 7, 0});
+        auto high = addLine(entity, {10, 7, 5}, {12, 5, 5});
+
+        auto const found = mycad::findIntersections(entity);
+
+        THEN("Touching Lines meet exactly at the end of one of them")
+        {
+            REQUIRE(std::ranges::count(found, mycad::Intersection{bar, stem, 0.25f, 0, false}) == 1);
+        }
+
+        THEN("Overlapping Lines report both ends of the overlap")
+        {
+            REQUIRE(std::ranges::count(found, mycad::Intersection{left, right, 0.5f, 1, true}) == 1);
+            REQUIRE(std::ranges::count(found, mycad::Intersection{left, right, 1, 0.5f, true}) == 1);
+        }
+
+        THEN("Lines that only share a Vertex are not reported")
+        {
+            REQUIRE(std::ranges::none_of(found, [&](mycad::Intersection const &x)
+            {
+                return x.first == up && x.second == across;
+            }));
+        }
+
+        THEN("The z coordinates are ignored")
+        {
+            REQUIRE(std::ranges::count(found, mycad::Intersection{low, high, 0.5f, 0.5f, false}) == 1);
+            REQUIRE(found.size() == 4);
+        }
+    }
+
+    GIVEN("A few thousand random Lines")
+    {
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> position(0, 100);
+        std::uniform_real_distribution<float> step(-8, 8);
+
+        mycad::Entity entity;
+        for (int i = 0; i < 2000; i++)
+        {
+            float const x = position(rng);
+            float const y = position(rng);
+            addLine(entity, {x, y, 0}, {x + step(rng), y + step(rng), 0});
+        }
+
+        auto const found = mycad::findIntersections(entity);
+
+        THEN("Every crossing is found exactly once")
+        {
+            REQUIRE(found.size() == bruteForceCrossings(entity));
+            REQUIRE(std::ranges::adjacent_find(found, [](auto const &a, auto const &b)
+            {
+                return a.first == b.first && a.second == b.second;
+            }) == found.end());
+        }
+
+        THEN("Splitting the work between threads gives the same answer")
+        {
+            REQUIRE(mycad::findIntersections(entity, 4) == found);
+            REQUIRE(mycad::findIntersections(entity, 0) == found);
+        }
+    }
+}
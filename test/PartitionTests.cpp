@@ -0,0 +1,120 @@
+#include "mycad/Partition.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+SCENARIO("010: Topology Partitioning", "[topology][partition]")
+{
+    GIVEN("A 20 x 20 grid of Vertices")
+    {
+        std::size_t const n = 20;
+        mycad::Topology topo;
+        for (std::size_t i = 0; i < n * n; i++)
+        {
+            topo.addFreeVertex();
+        }
+        for (std::size_t i = 0; i < n; i++)
+        {
+            for (std::size_t j = 0; j < n; j++)
+            {
+                mycad::VertexID const v = i * n + j;
+                if (i + 1 < n)
+                {
+                    topo.makeEdge(v, v + n);
+                }
+                if (j + 1 < n)
+                {
+                    topo.makeEdge(v, v + 1);
+                }
+            }
+        }
+        std::size_t const nEdges = topo.edgeIDs().size();
+
+        WHEN("It is split in to four parts")
+        {
+            auto partition = mycad::partition(topo, 4).value();
+
+            THEN("Every Vertex belongs to a part")
+            {
+                REQUIRE(partition.vertexParts.size() == n * n);
+                REQUIRE(std::ranges::all_of(partition.vertexParts,
+                                            [](auto p){return p < 4;}));
+            }
+
+            THEN("Every Edge belongs to exactly one part")
+            {
+                std::multiset<mycad::EdgeID> seen;
+                for (auto const &edges : partition.partEdges)
+                {
+                    seen.insert(edges.begin(), edges.end());
+                }
+
+                REQUIRE(seen.size() == nEdges);
+                REQUIRE(std::set(seen.begin(), seen.end()).size() == nEdges);
+                REQUIRE(partition.edgeParts.size() == nEdges);
+            }
+
+            THEN("The parts have roughly the same number of Edges")
+            {
+                for (auto const &edges : partition.partEdges)
+                {
+                    CHECK(edges.size() > nEdges / 5);
+                    CHECK(edges.size() < nEdges / 3);
+                }
+            }
+
+            THEN("Only Edges between parts are on the boundary")
+            {
+                for (auto const e : topo.edgeIDs())
+                {
+                    auto const [left, right] = *topo.getEdgeVertices(e);
+                    bool const crosses = partition.vertexParts.at(left) !=
+                                         partition.vertexParts.at(right);
+                    REQUIRE(std::ranges::count(partition.boundaryEdges, e) == (crosses ? 1 : 0));
+                }
+            }
+
+            THEN("Few Edges are cut")
+            {
+                REQUIRE(partition.boundaryEdges.size() < nEdges / 8);
+            }
+        }
+    }
+
+    GIVEN("Two disconnected Edges and a free Vertex")
+    {
+        mycad::Topology topo;
+        auto v0 = topo.addFreeVertex();
+        auto v1 = topo.addFreeVertex();
+        auto v2 = topo.addFreeVertex();
+        auto v3 = topo.addFreeVertex();
+        topo.addFreeVertex();
+        topo.makeEdge(v0, v1);
+        topo.makeEdge(v2, v3);
+
+        THEN("Each connected piece can be a part of its own")
+        {
+            auto partition = mycad::partition(topo, 2).value();
+
+            REQUIRE(partition.boundaryEdges.empty());
+            REQUIRE(partition.partEdges.at(0).size() == 1);
+            REQUIRE(partition.partEdges.at(1).size() == 1);
+        }
+
+        THEN("There can be more parts than Vertices")
+        {
+            auto partition = mycad::partition(topo, 10).value();
+
+            REQUIRE(partition.partEdges.size() == 10);
+            REQUIRE(partition.vertexParts.size() == 5);
+        }
+    }
+
+    THEN("A Topology can't be split in to zero parts")
+    {
+        REQUIRE_FALSE(mycad::partition(mycad::Topology(), 0).has_value());
+    }
+}
@@ -0,0 +1,230 @@
+#include "mycad/PointArray.h"
+#include "Arbitrary.h"
+
+#include <catch2/catch.hpp>
+#include "rapidcheck/catch.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    // enough Points to cover whole SIMD vectors as well as left-overs
+    auto makePoints(std::size_t n) -> std::vector<mycad::Point>
+    {
+        std::vector<mycad::Point> out;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            float const f = static_cast<float>(i);
+            out.push_back({f, -2 * f, std::sin(f) * 10});
+        }
+        return out;
+    }
+}
+
+SCENARIO( "012: Bounding Boxes", "[geometry][boundingbox]" )
+{
+    GIVEN("A box made from two Points")
+    {
+        mycad::BoundingBox box = mycad::makeBoundingBox({1, 5, -1}, {-1, 2, 3});
+
+        THEN("The box is ordered from its smallest to its largest corner")
+        {
+            REQUIRE(box.min == mycad::Point{-1, 2, -1});
+            REQUIRE(box.max == mycad::Point{1, 5, 3});
+        }
+
+        THEN("Points inside or on the box are contained")
+        {
+            REQUIRE(box.contains({0, 3, 0}));
+            REQUIRE(box.contains({1, 5, 3}));
+            REQUIRE_FALSE(box.contains({0, 6, 0}));
+        }
+
+        THEN("Touching boxes intersect, separate ones don't")
+        {
+            REQUIRE(box.intersects(mycad::makeBoundingBox({1, 5, 3}, {2, 6, 4})));
+            REQUIRE_FALSE(box.intersects(mycad::makeBoundingBox({1.5, 0, 0}, {2, 6, 4})));
+        }
+
+        WHEN("It is expanded")
+        {
+            box.expand(mycad::Point{10, 0, 0});
+
+            THEN("It grows just enough")
+            {
+                REQUIRE(box == mycad::makeBoundingBox({-1, 0, -1}, {10, 5, 3}));
+            }
+        }
+    }
+}
+
+SCENARIO( "013: Structure-of-arrays Points", "[geometry][pointarray]" )
+{
+    rc::prop("Points can be recovered from a PointArray",
+        [](mycad::Point const &p1, mycad::Point const &p2)
+        {
+            mycad::PointArray points;
+            points.append(p1);
+            points.append(p2);
+
+            RC_ASSERT(points.size() == 2u);
+            RC_ASSERT(points.at(0) == p1);
+            RC_ASSERT(points.at(1) == p2);
+        },
+        /* verbose= */ true
+    );
+
+    GIVEN("A PointArray with a partial SIMD vector at the end")
+    {
+        auto const original = makePoints(37);
+        mycad::PointArray points(original);
+
+        THEN("The components are available as contiguous lanes")
+        {
+            REQUIRE(points.xs().size() == 37);
+            REQUIRE(points.ys()[5] == original.at(5).y);
+        }
+
+        THEN("The bounds cover every Point")
+        {
+            mycad::BoundingBox expected{original.front(), original.front()};
+            for (auto const &p : original)
+            {
+                expected.expand(p);
+            }
+
+            REQUIRE(points.bounds() == expected);
+        }
+
+        THEN("Masked bounds cover only the Points left in")
+        {
+            // Leave out every third Point, and the ends which set the x range
+            std::vector<float> mask(original.size(), 1);
+            mask.front() = 0;
+            mask.back() = 0;
+            for (std::size_t i = 0; i < mask.size(); i += 3)
+            {
+                mask[i] = 0;
+            }
+
+            mycad::MaybeBoundingBox expected;
+            for (std::size_t i = 0; i < original.size(); i++)
+            {
+                if (mask[i] == 0)
+                {
+                    continue;
+                }
+                if (expected.has_value())
+                {
+                    expected->expand(original[i]);
+                }
+                else
+                {
+                    expected = mycad::BoundingBox{original[i], original[i]};
+                }
+            }
+
+            REQUIRE(points.bounds(mask) == expected);
+            REQUIRE_FALSE(points.bounds(std::vector<float>(37, 0)).has_value());
+            REQUIRE_THROWS_AS(points.bounds(std::vector<float>(36, 1)), std::out_of_range);
+        }
+
+        THEN("Distances are the same as when computed one at a time")
+        {
+            mycad::Point const p{1, 2, 3};
+            std::vector<float> distances(points.size());
+            REQUIRE(points.distancesTo(p, distances));
+
+            for (std::size_t i = 0; i < original.size(); i++)
+            {
+                auto const &q = original.at(i);
+                float const expected = std::sqrt((q.x - 1) * (q.x - 1) +
+                                                 (q.y - 2) * (q.y - 2) +
+                                                 (q.z - 3) * (q.z - 3));
+                REQUIRE(distances.at(i) == Approx(expected));
+            }
+
+            std::vector<float> tooSmall(points.size() - 1);
+            REQUIRE_FALSE(points.distancesTo(p, tooSmall));
+        }
+
+        WHEN("They are transformed")
+        {
+            // rotate 90° about z, then move up by 5
+            mycad::Matrix4 const m{0, -1, 0, 0,
+                                   1,  0, 0, 0,
+                                   0,  0, 1, 5,
+                                   0,  0, 0, 1};
+            points.transform(m);
+
+            THEN("Every Point has been transformed")
+            {
+                for (std::size_t i = 0; i < original.size(); i++)
+                {
+                    auto const &p = original.at(i);
+                    REQUIRE(points.at(i) == mycad::Point{-p.y, p.x, p.z + 5});
+                }
+            }
+        }
+
+        WHEN("They are translated and scaled")
+        {
+            points.translate({1, 1, 1});
+            points.scale(2, {1, 1, 1});
+
+            THEN("Every Point has moved")
+            {
+                for (std::size_t i = 0; i < original.size(); i++)
+                {
+                    auto const &p = original.at(i);
+                    REQUIRE(points.at(i).x == Approx(1 + 2 * p.x));
+                    REQUIRE(points.at(i).y == Approx(1 + 2 * p.y));
+                    REQUIRE(points.at(i).z == Approx(1 + 2 * p.z));
+                }
+            }
+        }
+
+        WHEN("More Points are appended")
+        {
+            points.append({100, 100, 100});
+
+            THEN("The bounds grow to include them")
+            {
+                REQUIRE(points.bounds()->max == mycad::Point{100, 100, 100});
+            }
+        }
+
+        WHEN("It is shrunk and grown again")
+        {
+            points.resize(20);
+            points.resize(40);
+
+            THEN("The first Points are kept and the new ones are at the origin")
+            {
+                REQUIRE(points.size() == 40);
+                REQUIRE(points.at(19) == original.at(19));
+                REQUIRE(points.at(20) == mycad::Point{0, 0, 0});
+                REQUIRE(points.at(39) == mycad::Point{0, 0, 0});
+            }
+        }
+
+        WHEN("It is shrunk")
+        {
+            points.resize(20);
+
+            THEN("The dropped Points can't be read or written")
+            {
+                REQUIRE(points.at(19) == original.at(19));
+                REQUIRE_THROWS_AS(points.at(20), std::out_of_range);
+                REQUIRE_THROWS_AS(points.set(20, {1, 1, 1}), std::out_of_range);
+            }
+        }
+    }
+
+    THEN("An empty PointArray has no bounds")
+    {
+        REQUIRE_FALSE(mycad::PointArray().bounds().has_value());
+    }
+}
@@ -0,0 +1,124 @@
+#include "mycad/Predicates.h"
+#include "Arbitrary.h"
+
+#include <catch2/catch.hpp>
+#include "rapidcheck/catch.h"
+
+using mycad::Orientation;
+
+SCENARIO( "014: Robust predicates", "[geometry][predicates]" )
+{
+    GIVEN("Three Points in the xy plane")
+    {
+        mycad::Point const a{0, 0, 0};
+        mycad::Point const b{1, 0, 5};
+        mycad::Point const c{0, 1, -5};
+
+        THEN("Their orientation only depends on the order they're visited in")
+        {
+            REQUIRE(mycad::orient2d(a, b, c) == Orientation::Positive);
+            REQUIRE(mycad::orient2d(b, c, a) == Orientation::Positive);
+            REQUIRE(mycad::orient2d(a, c, b) == Orientation::Negative);
+            REQUIRE(mycad::orient2d(a, b, {2, 0, 0}) == Orientation::Zero);
+        }
+    }
+
+    GIVEN("Three Points which are nearly collinear")
+    {
+        // Evaluating this in double gives exactly zero: the answer is only
+        // available from the exact fall-back
+        mycad::Point const a{-0.5f, 24, 0};
+        mycad::Point const b{-0.5f, -0.5f, 0};
+        mycad::Point const c{-24, -1e30f, 0};
+
+        THEN("Their orientation is still correct")
+        {
+            REQUIRE(mycad::orient2d(a, b, c) == Orientation::Negative);
+            REQUIRE(mycad::orient2d(b, a, c) == Orientation::Positive);
+        }
+    }
+
+    GIVEN("Four Points")
+    {
+        mycad::Point const a{0, 0, 0};
+        mycad::Point const b{1, 0, 0};
+        mycad::Point const c{0, 1, 0};
+
+        THEN("orient3d tells us which side of the plane the fourth is on")
+        {
+            REQUIRE(mycad::orient3d(a, b, c, {0, 0, -1}) == Orientation::Positive);
+            REQUIRE(mycad::orient3d(a, b, c, {0, 0, 1}) == Orientation::Negative);
+            REQUIRE(mycad::orient3d(a, b, c, {3, -7, 0}) == Orientation::Zero);
+            REQUIRE(mycad::orient3d(a, b, c, {1, 1, 1e-30f}) == Orientation::Negative);
+        }
+    }
+
+    GIVEN("A Line with constant x")
+    {
+        mycad::Line const line = mycad::makeLine({2, 0, 0}, {2, 10, 0}).value();
+
+        THEN("Points on it intersect it")
+        {
+            REQUIRE(line.intersects({2, 5, 0}));
+            REQUIRE(line.intersects({2, -5, 0}));
+            REQUIRE(mycad::onSegment(line, {2, 5, 0}));
+            REQUIRE(mycad::collinear(line.atU(0), line.atU(1), {2, 7.25f, 0}));
+        }
+
+        THEN("Points off it do not")
+        {
+            REQUIRE_FALSE(line.intersects({2.0001f, 5, 0}));
+            REQUIRE_FALSE(line.intersects({2, 5, 1}));
+            REQUIRE_FALSE(mycad::onSegment(line, {2, -5, 0}));
+        }
+
+        THEN("A tolerance can be given")
+        {
+            REQUIRE(mycad::onSegment(line, {2.0001f, 5, 0}, 1e-3f));
+            REQUIRE(mycad::onSegment(line, {2, 10.0005f, 0}, 1e-3f));
+            REQUIRE_FALSE(mycad::onSegment(line, {2.01f, 5, 0}, 1e-3f));
+            REQUIRE_FALSE(mycad::onSegment(line, {2, -5, 0}, 1e-3f));
+        }
+    }
+
+    GIVEN("Two Lines along the same direction")
+    {
+        mycad::Line const line1 = mycad::makeLine({0, 0, 0}, {1, 2, 3}).value();
+        mycad::Line const line2 = mycad::makeLine({2, 4, 6}, {-1, -2, -3}).value();
+        mycad::Line const line3 = mycad::makeLine({0, 0, 1e-4f}, {1, 2, 3}).value();
+
+        THEN("They are coincident if they share the same infinite line")
+        {
+            REQUIRE(mycad::coincident(line1, line2));
+            REQUIRE_FALSE(mycad::coincident(line1, line3));
+            REQUIRE(mycad::coincident(line1, line3, 1e-3f));
+            REQUIRE_FALSE(mycad::coincident(line1, line3, 1e-6f));
+        }
+    }
+
+    rc::prop("Nearby Points are coincident within a tolerance",
+        []()
+        {
+            mycad::Point const p{static_cast<float>(*rc::gen::inRange(-1000, 1000)),
+                                 static_cast<float>(*rc::gen::inRange(-1000, 1000)),
+                                 static_cast<float>(*rc::gen::inRange(-1000, 1000))};
+            mycad::Point q = p;
+            q.x += 0.25f;
+
+            RC_ASSERT(mycad::coincident(p, p, 0));
+            RC_ASSERT(mycad::coincident(p, q, 0.5f));
+            RC_ASSERT_FALSE(mycad::coincident(p, q, 0.125f));
+        }
+    );
+
+    rc::prop("Orientation flips when two Points are swapped",
+        [](mycad::Point const &a, mycad::Point const &b, mycad::Point const &c)
+        {
+            auto flip = [](Orientation o){return static_cast<Orientation>(-static_cast<int>(o));};
+
+            RC_ASSERT(mycad::orient2d(b, a, c) == flip(mycad::orient2d(a, b, c)));
+            RC_ASSERT(mycad::orient3d(b, a, c, {0, 0, 0}) ==
+                      flip(mycad::orient3d(a, b, c, {0, 0, 0})));
+        }
+    );
+}
@@ -0,0 +1,100 @@
+#include "mycad/PreparedLine.h"
+#include "mycad/Predicates.h"
+#include "Arbitrary.h"
+
+#include <catch2/catch.hpp>
+#include "rapidcheck/catch.h"
+
+#include <cmath>
+
+SCENARIO( "018: Prepared Lines", "[geometry][preparedline]" )
+{
+    rc::prop("A PreparedLine describes the same Line",
+        [](mycad::Line const &line)
+        {
+            mycad::PreparedLine const prepared(line);
+            float const u = *rc::gen::inRange(0, 1);
+
+            RC_ASSERT(prepared.line() == line);
+            RC_ASSERT(prepared.atU(u) == line.atU(u));
+            RC_ASSERT(prepared.box() == mycad::makeBoundingBox(line));
+        }
+    );
+
+    rc::prop("The closest point is never further away than either end",
+        [](mycad::Line const &line, mycad::Point const &p)
+        {
+            mycad::PreparedLine const prepared(line);
+            mycad::Point const q = prepared.closestPoint(p);
+
+            auto squared = [&p](mycad::Point const &a)
+            {
+                return (a.x - p.x) * (a.x - p.x) + (a.y - p.y) * (a.y - p.y) +
+                       (a.z - p.z) * (a.z - p.z);
+            };
+
+            float const d = prepared.distanceSquared(p);
+            RC_ASSERT(d == squared(q));
+            RC_ASSERT(d <= squared(line.atU(0)) * 1.0001f);
+            RC_ASSERT(d <= squared(line.atU(1)) * 1.0001f);
+        }
+    );
+
+    GIVEN("A Line along the x axis")
+    {
+        mycad::PreparedLine const line(mycad::makeLine({1, 0, 0}, {5, 0, 0}).value());
+
+        THEN("Its direction and length are known up front")
+        {
+            REQUIRE(line.direction() == mycad::Point{4, 0, 0});
+            REQUIRE(line.lengthSquared() == 16);
+            REQUIRE(line.length() == 4);
+            REQUIRE(line.inverseLength() == 0.25f);
+        }
+
+        THEN("Points project onto it, beyond either end too")
+        {
+            REQUIRE(line.project({1, 7, 0}) == 0);
+            REQUIRE(line.project({4, 0, -2}) == 0.75f);
+            REQUIRE(line.project({9, 1, 1}) == 2);
+            REQUIRE(line.project({-3, 0, 0}) == -1);
+        }
+
+        THEN("The closest point stays between the ends")
+        {
+            REQUIRE(line.closestPoint({3, 2, 0}) == mycad::Point{3, 0, 0});
+            REQUIRE(line.closestPoint({9, 0, 0}) == mycad::Point{5, 0, 0});
+            REQUIRE(line.distance({3, 3, 4}) == 5);
+            REQUIRE(line.distance({8, 4, 0}) == 5);
+        }
+
+        THEN("Containment agrees with onSegment")
+        {
+            for (mycad::Point const &p : {mycad::Point{3, 0.5f, 0}, mycad::Point{3, 0, 2},
+                                          mycad::Point{0.5f, 0, 0}, mycad::Point{6, 0, 0},
+                                          mycad::Point{5, 0.99f, 0}})
+            {
+                REQUIRE(line.contains(p, 1) == mycad::onSegment(line.line(), p, 1));
+            }
+        }
+
+        THEN("It crosses the boxes that it passes through")
+        {
+            REQUIRE(line.crosses({{2, -1, -1}, {3, 1, 1}}));
+            REQUIRE(line.crosses({{5, 0, 0}, {6, 1, 1}}));
+            REQUIRE_FALSE(line.crosses({{2, 0.5f, -1}, {3, 1, 1}}));
+            REQUIRE_FALSE(line.crosses({{6, -1, -1}, {7, 1, 1}}));
+        }
+    }
+
+    GIVEN("A diagonal Line")
+    {
+        mycad::PreparedLine const line(mycad::makeLine({0, 0, 0}, {4, 4, 0}).value());
+
+        THEN("It only crosses the boxes that it passes through, not ones its box overlaps")
+        {
+            REQUIRE(line.crosses({{1, 1, -1}, {2, 2, 1}}));
+            REQUIRE_FALSE(line.crosses({{3, 0, -1}, {4, 1, 1}}));
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#include "mycad/render_helpers.h"
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+SCENARIO("031: Line meshes straight from an Entity", "[render][linemesh]")
+{
+    GIVEN("An Entity with a few of its Edges removed")
+    {
+        // A fan of Lines, so that no two segments share a vertex
+        mycad::Entity entity;
+        auto centre = entity.addVertex({0, 0, 0});
+        std::vector<mycad::EdgeID> edges;
+        for (int i = 0; i < 20; i++)
+        {
+            float const f = static_cast<float>(i + 1);
+            auto v = entity.addVertex({f, 2 * f, -f});
+            edges.push_back(entity.addEdge(centre, v).value());
+        }
+
+        for (std::size_t i : {0, 7, 8, 19})
+        {
+            REQUIRE(entity.removeEdge(edges[i]));
+        }
+
+        std::vector<mycad::Line> live;
+        for (auto const entry : entity.edges())
+        {
+            live.push_back(entry.line);
+        }
+
+        THEN("Each live Edge gets the segment addSegment would make, whatever the thread count")
+        {
+            for (unsigned threads : {1u, 3u, 0u})
+            {
+                auto const mesh = makeLineMesh(entity, threads).value();
+
+                REQUIRE(mesh.getVertices().size() == 4 * live.size());
+                REQUIRE(mesh.getIndices().size() == 6 * live.size());
+
+                for (std::size_t s = 0; s < live.size(); s++)
+                {
+                    mycad::Point const p1 = live[s].atU(0);
+                    mycad::Point const p2 = live[s].atU(1);
+                    LineMesh const one({p1.x, p1.y, p1.z}, {p2.x, p2.y, p2.z});
+
+                    for (std::size_t i = 0; i < 4; i++)
+                    {
+                        REQUIRE(mesh.getVertices()[4 * s + i] == one.getVertices()[i]);
+                    }
+                    for (std::size_t i = 0; i < 6; i++)
+                    {
+                        REQUIRE(mesh.getIndices()[6 * s + i] - 4 * s == one.getIndices()[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN("An Entity without any Edges")
+    {
+        mycad::Entity entity;
+        entity.addVertex({1, 2, 3});
+
+        THEN("There is no mesh")
+        {
+            REQUIRE_FALSE(makeLineMesh(entity).has_value());
+        }
+    }
+}
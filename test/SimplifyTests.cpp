@@ -0,0 +1,180 @@
+#include "mycad/Simplify.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Walks an open Chain through @param points, one Edge between each pair
+    auto addChain(mycad::Entity &entity, std::vector<mycad::Point> const &points)
+        -> mycad::Chain
+    {
+        std::vector<mycad::VertexID> vertices;
+        for (auto const &p : points)
+        {
+            vertices.push_back(entity.addVertex(p));
+        }
+
+        std::vector<mycad::EdgeID> edges;
+        for (std::size_t i = 0; i + 1 < vertices.size(); i++)
+        {
+            edges.push_back(entity.addEdge(vertices[i], vertices[i + 1]).value());
+        }
+
+        auto chain = entity.joinEdges(edges[0], edges[1]).value();
+        for (std::size_t i = 2; i < edges.size(); i++)
+        {
+            REQUIRE(entity.extendChain(chain, edges[i]));
+        }
+
+        return chain;
+    }
+
+    // Walks round a square of side @param side in @param n steps per side
+    auto square(float side, int n) -> std::vector<mycad::Point>
+    {
+        std::vector<mycad::Point> points;
+        mycad::Point const corners[] = {{0, 0, 0}, {side, 0, 0}, {side, side, 0}, {0, side, 0}};
+        for (int c = 0; c < 4; c++)
+        {
+            auto const &from = corners[c];
+            auto const &to = corners[(c + 1) % 4];
+            for (int i = 0; i < n; i++)
+            {
+                float const t = static_cast<float>(i) / static_cast<float>(n);
+                points.push_back({from.x + t * (to.x - from.x), from.y + t * (to.y - from.y), 0});
+            }
+        }
+        points.push_back(corners[0]);
+
+        return points;
+    }
+}
+
+SCENARIO( "023: Polyline simplification", "[entity][simplify]" )
+{
+    GIVEN("Two Points or fewer")
+    {
+        std::vector<mycad::Point> const points{{0, 0, 0}, {1, 1, 1}};
+
+        THEN("There's nothing to drop")
+        {
+            REQUIRE(mycad::simplify(points, 10) == points);
+            REQUIRE(mycad::simplify({}, 10).empty());
+        }
+    }
+
+    GIVEN("A long, slightly noisy straight line")
+    {
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<float> noise(-1e-3f, 1e-3f);
+
+        std::vector<mycad::Point> points;
+        for (int i = 0; i <= 10000; i++)
+        {
+            points.push_back({static_cast<float>(i) / 100, noise(gen), noise(gen)});
+        }
+
+        THEN("A tolerance above the noise leaves just the ends")
+        {
+            auto const simple = mycad::simplify(points, 0.01f);
+            REQUIRE(simple == std::vector<mycad::Point>{points.front(), points.back()});
+        }
+
+        THEN("A tolerance below the noise keeps some of it")
+        {
+            REQUIRE(mycad::simplify(points, 1e-5f).size() > 2);
+        }
+    }
+
+    GIVEN("A finely sampled closed square")
+    {
+        auto const points = square(10, 100);
+
+        THEN("Only the corners are left, and it stays closed")
+        {
+            auto const simple = mycad::simplify(points, 0.01f);
+            REQUIRE(simple == std::vector<mycad::Point>{
+                {0, 0, 0}, {10, 0, 0}, {10, 10, 0}, {0, 10, 0}, {0, 0, 0}});
+        }
+    }
+
+    GIVEN("A zigzag whose teeth are taller than the tolerance")
+    {
+        std::vector<mycad::Point> points;
+        for (int i = 0; i < 50; i++)
+        {
+            points.push_back({static_cast<float>(i), static_cast<float>(i % 2), 0});
+        }
+
+        THEN("Every Point is kept")
+        {
+            REQUIRE(mycad::simplify(points, 0.1f) == points);
+        }
+    }
+
+    GIVEN("A spike that doubles back along the line between its neighbours")
+    {
+        std::vector<mycad::Point> const points{{0, 0, 0}, {10, 0, 0}, {1, 0, 0}, {2, 1, 0}};
+
+        THEN("The tip of the spike is kept")
+        {
+            auto const simple = mycad::simplify(points, 0.5f);
+            REQUIRE(std::ranges::find(simple, mycad::Point{10, 0, 0}) != simple.end());
+        }
+    }
+
+    GIVEN("An Entity with several Chains")
+    {
+        mycad::Entity entity;
+        std::vector<mycad::Chain> chains;
+        std::vector<std::vector<mycad::Point>> expected;
+
+        for (int k = 1; k <= 10; k++)
+        {
+            std::vector<mycad::Point> points;
+            for (int i = 0; i <= 50 * k; i++)
+            {
+                double const angle = std::numbers::pi * i / (50.0 * k);
+                points.push_back({static_cast<float>(k * std::cos(angle)),
+                                  static_cast<float>(k * std::sin(angle)),
+                                  static_cast<float>(k)});
+            }
+            chains.push_back(addChain(entity, points));
+            expected.push_back(mycad::simplify(points, 0.01f));
+        }
+
+        auto const before = entity.getEdges();
+
+        THEN("Each is simplified the same, with any number of threads")
+        {
+            for (unsigned threads : {0u, 1u, 3u, 16u})
+            {
+                REQUIRE(mycad::simplifyChains(entity, chains, 0.01f, threads) == expected);
+            }
+        }
+
+        THEN("Fewer Points are left, and the Entity isn't changed")
+        {
+            auto const simple = mycad::simplifyChains(entity, chains, 0.01f);
+            for (std::size_t k = 0; k < chains.size(); k++)
+            {
+                REQUIRE(simple[k].size() < entity.getChainGeometry(chains[k])->size() + 1);
+            }
+            REQUIRE(entity.getEdges() == before);
+        }
+
+        THEN("A Chain that doesn't exist gives no Points")
+        {
+            std::vector<mycad::Chain> const missing{{999, 999}};
+            auto const simple = mycad::simplifyChains(entity, missing, 0.01f);
+            REQUIRE(simple.size() == 1);
+            REQUIRE(simple[0].empty());
+        }
+    }
+}
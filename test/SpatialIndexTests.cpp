@@ -0,0 +1,355 @@
+#include "mycad/SpatialIndex.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Points scattered through a 100x100x10 box, with a few exact duplicates
+    auto makeCloud(std::size_t n) -> std::vector<mycad::Point>
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> xy(0, 100);
+        std::uniform_real_distribution<float> z(0, 10);
+
+        std::vector<mycad::Point> out;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            out.push_back(i % 50 == 49 ? out[i / 2] : mycad::Point{xy(rng), xy(rng), z(rng)});
+        }
+        return out;
+    }
+
+    auto distance(mycad::Point const &a, mycad::Point const &b) -> float
+    {
+        return std::hypot(a.x - b.x, a.y - b.y, a.z - b.z);
+    }
+
+    // The distance to the closest of @param live (by id), the slow way
+    auto bruteNearest(std::vector<mycad::Point> const &points,
+                      std::vector<bool> const &live, mycad::Point const &p) -> float
+    {
+        float best = std::numeric_limits<float>::infinity();
+        for (std::size_t i = 0; i < points.size(); i++)
+        {
+            if (live[i])
+            {
+                best = std::min(best, distance(points[i], p));
+            }
+        }
+        return best;
+    }
+
+    auto bruteRadius(std::vector<mycad::Point> const &points,
+                     std::vector<bool> const &live, mycad::Point const &p, float r)
+        -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> out;
+        for (std::size_t i = 0; i < points.size(); i++)
+        {
+            if (live[i] && distance(points[i], p) <= r)
+            {
+                out.push_back(i);
+            }
+        }
+        return out;
+    }
+
+    auto idsOf(mycad::Neighbours const &found) -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> out;
+        for (auto const &n : found)
+        {
+            out.push_back(n.id);
+        }
+        std::ranges::sort(out);
+        return out;
+    }
+
+    auto queries() -> std::vector<mycad::Point>
+    {
+        std::vector<mycad::Point> out;
+        for (float x = -20; x < 120; x += 13.7f)
+        {
+            for (float y = -20; y < 120; y += 11.3f)
+            {
+                out.push_back({x, y, x / 20});
+            }
+        }
+        return out;
+    }
+}
+
+SCENARIO("016: Point spatial indices", "[geometry][spatialindex]")
+{
+    std::vector<mycad::Point> const cloud = makeCloud(2000);
+    std::vector<bool> live(cloud.size(), true);
+
+    GIVEN("A PointGrid and a KdTree over the same Points")
+    {
+        mycad::PointGrid grid(5);
+        for (std::size_t i = 0; i < cloud.size(); i++)
+        {
+            REQUIRE(grid.insert(i, cloud[i]));
+        }
+        mycad::KdTree tree(cloud);
+
+        REQUIRE(grid.size() == cloud.size());
+        REQUIRE(tree.size() == cloud.size());
+        REQUIRE_FALSE(grid.insert(3, {0, 0, 0}));
+        REQUIRE_FALSE(tree.insert(3, {0, 0, 0}));
+
+        auto check = [&]()
+        {
+            for (auto const &p : queries())
+            {
+                float const expected = bruteNearest(cloud, live, p);
+
+                auto const fromGrid = grid.nearest(p);
+                auto const fromTree = tree.nearest(p);
+                REQUIRE(fromGrid.has_value());
+                REQUIRE(fromTree.has_value());
+                REQUIRE(fromGrid->distance == Approx(expected));
+                REQUIRE(fromTree->distance == Approx(expected));
+                REQUIRE(live[fromGrid->id]);
+                REQUIRE(live[fromTree->id]);
+
+                auto const expectedIds = bruteRadius(cloud, live, p, 8);
+                REQUIRE(idsOf(grid.withinRadius(p, 8)) == expectedIds);
+                REQUIRE(idsOf(tree.withinRadius(p, 8)) == expectedIds);
+            }
+        };
+
+        THEN("Nearest and radius queries match a brute-force search")
+        {
+            check();
+        }
+
+        THEN("Nothing is found beyond the maximum distance")
+        {
+            REQUIRE_FALSE(grid.nearest({500, 500, 500}, 10).has_value());
+            REQUIRE_FALSE(tree.nearest({500, 500, 500}, 10).has_value());
+            REQUIRE(grid.nearest({500, 500, 500}).has_value());
+            REQUIRE(tree.nearest({500, 500, 500}).has_value());
+        }
+
+        THEN("The k nearest come back closest first")
+        {
+            mycad::Point const p{50, 50, 5};
+            auto const found = tree.kNearest(p, 10);
+
+            std::vector<float> distances;
+            for (auto const &q : cloud)
+            {
+                distances.push_back(distance(p, q));
+            }
+            std::ranges::sort(distances);
+
+            REQUIRE(found.size() == 10);
+            for (std::size_t i = 0; i < found.size(); i++)
+            {
+                REQUIRE(found[i].distance == Approx(distances[i]));
+            }
+        }
+
+        THEN("Batches of queries give the same answers as one at a time")
+        {
+            auto const ps = queries();
+            std::vector<mycad::MaybeNeighbour> fromGrid(ps.size()), fromTree(ps.size());
+
+            REQUIRE(grid.nearest(ps, fromGrid));
+            REQUIRE(tree.nearest(ps, fromTree));
+            for (std::size_t i = 0; i < ps.size(); i++)
+            {
+                REQUIRE(fromGrid[i]->distance == grid.nearest(ps[i])->distance);
+                REQUIRE(fromTree[i]->distance == tree.nearest(ps[i])->distance);
+            }
+
+            fromGrid.pop_back();
+            REQUIRE_FALSE(grid.nearest(ps, fromGrid));
+        }
+
+        WHEN("Points still waiting to go into the tree are removed")
+        {
+            // Few enough that the tree isn't rebuilt around them
+            for (std::size_t i = 0; i < 100; i++)
+            {
+                mycad::Point const p{static_cast<float>(i), 200, 0};
+                REQUIRE(tree.insert(cloud.size() + i, p));
+            }
+            for (std::size_t i = 0; i < 100; i += 2)
+            {
+                REQUIRE(tree.remove(cloud.size() + i));
+            }
+            REQUIRE_FALSE(tree.remove(cloud.size()));
+
+            THEN("Only the others are left")
+            {
+                REQUIRE(tree.size() == cloud.size() + 50);
+                for (std::size_t i = 0; i < 100; i++)
+                {
+                    REQUIRE(tree.contains(cloud.size() + i) == (i % 2 == 1));
+
+                    auto const found = tree.nearest({static_cast<float>(i) + 0.25f, 200, 0});
+                    REQUIRE(found->id == cloud.size() + (i % 2 == 1 ? i : i + 1));
+                }
+            }
+        }
+
+        WHEN("Points are removed, moved and added")
+        {
+            std::vector<mycad::Point> points = cloud;
+            for (std::size_t i = 0; i < cloud.size(); i += 3)
+            {
+                REQUIRE(grid.remove(i));
+                REQUIRE(tree.remove(i));
+                live[i] = false;
+            }
+            REQUIRE_FALSE(grid.remove(0));
+            REQUIRE_FALSE(tree.remove(0));
+
+            for (std::size_t i = 1; i < cloud.size(); i += 3)
+            {
+                mycad::Point const moved{points[i].y, points[i].x, 10 - points[i].z};
+                REQUIRE(grid.move(i, moved));
+                REQUIRE(tree.remove(i));
+                REQUIRE(tree.insert(i, moved));
+                points[i] = moved;
+            }
+
+            for (std::size_t i = 0; i < 500; i++)
+            {
+                mycad::Point const p{static_cast<float>(i % 100), 0.5f * static_cast<float>(i % 7), 1};
+                REQUIRE(grid.insert(points.size(), p));
+                REQUIRE(tree.insert(points.size(), p));
+                points.push_back(p);
+                live.push_back(true);
+            }
+
+            THEN("Queries only see the Points as they are now")
+            {
+                std::size_t const alive = static_cast<std::size_t>(std::ranges::count(live, true));
+                REQUIRE(grid.size() == alive);
+                REQUIRE(tree.size() == alive);
+
+                for (auto const &p : queries())
+                {
+                    float const expected = bruteNearest(points, live, p);
+                    REQUIRE(grid.nearest(p)->distance == Approx(expected));
+                    REQUIRE(tree.nearest(p)->distance == Approx(expected));
+
+                    auto const expectedIds = bruteRadius(points, live, p, 8);
+                    REQUIRE(idsOf(grid.withinRadius(p, 8)) == expectedIds);
+                    REQUIRE(idsOf(tree.withinRadius(p, 8)) == expectedIds);
+                }
+            }
+        }
+    }
+
+    GIVEN("A PointGrid over a flat drawing")
+    {
+        mycad::PointGrid grid(1);
+        grid.insert(0, {0, 0, 0});
+        grid.insert(1, {100, 0, 0});
+
+        THEN("A query far from any Point still finds the closest")
+        {
+            REQUIRE(grid.nearest({40, 30, 0})->id == 0);
+            REQUIRE(grid.nearest({60, -30, 0})->id == 1);
+            REQUIRE(grid.nearest({1e6f, 0, 0})->id == 1);
+        }
+
+        THEN("A radius query larger than the drawing finds everything")
+        {
+            REQUIRE(grid.withinRadius({50, 0, 0}, 1000).size() == 2);
+        }
+    }
+
+    GIVEN("A sparse PointGrid with cells far smaller than the gaps between its Points")
+    {
+        // Thousands of rings lie between the query and either Point
+        mycad::PointGrid grid(0.01f);
+        grid.insert(0, {0, 0, 0});
+        grid.insert(1, {50, 50, 0});
+
+        THEN("A query far from both Points still finds the closest")
+        {
+            REQUIRE(grid.nearest({25, 25.1f, 0})->id == 1);
+            REQUIRE(grid.nearest({24.9f, 25, 0})->id == 0);
+            REQUIRE_FALSE(grid.nearest({25, 25, 0}, 1).has_value());
+        }
+
+        THEN("A Point millions of cells away doesn't make every query walk to it")
+        {
+            grid.insert(2, {200'000, 0, 0});
+
+            REQUIRE(grid.nearest({1, 0, 0})->id == 0);
+            REQUIRE(grid.nearest({199'000, 0, 0})->id == 2);
+        }
+
+        WHEN("The Point on the edge of the grid is removed and another added")
+        {
+            grid.remove(1);
+            grid.insert(2, {0, 1, 0});
+
+            THEN("Queries only search around the Points that are left")
+            {
+                REQUIRE(grid.nearest({0, 0.6f, 0})->id == 2);
+                REQUIRE(grid.nearest({50, 50, 0})->id == 2);
+                REQUIRE(grid.withinRadius({50, 50, 0}, 1).empty());
+            }
+        }
+    }
+
+    GIVEN("A PointGrid holding a Point with NaN coordinates")
+    {
+        float constexpr nan = std::numeric_limits<float>::quiet_NaN();
+
+        mycad::PointGrid grid(1);
+        grid.insert(0, {nan, nan, nan});
+        grid.insert(1, {3, 0, 0});
+
+        THEN("Queries skip it rather than failing")
+        {
+            REQUIRE(grid.nearest({0, 0, 0})->id == 1);
+            REQUIRE(grid.withinRadius({0, 0, 0}, 10).size() == 1);
+            REQUIRE(grid.remove(0));
+        }
+    }
+
+    GIVEN("Points on a grid far from the origin, in cells smaller than their spacing")
+    {
+        THEN("Each Point finds only itself, however far out it is")
+        {
+            // e.g. survey coordinates, where each Point has a cell to itself
+            for (float const offset : {1e4f, 1e5f, 1e6f, 5e6f, 1e7f})
+            {
+                mycad::PointGrid grid(1);
+                std::vector<mycad::Point> points;
+                for (int i = 0; i < 60; i++)
+                {
+                    for (int j = 0; j < 60; j++)
+                    {
+                        points.push_back({offset + 2.0f * static_cast<float>(i),
+                                          offset + 2.0f * static_cast<float>(j), 0});
+                        REQUIRE(grid.insert(points.size() - 1, points.back()));
+                    }
+                }
+
+                for (std::size_t i = 0; i < points.size(); i++)
+                {
+                    REQUIRE(grid.nearest(points[i])->id == i);
+
+                    auto const found = grid.withinRadius(points[i], 1);
+                    REQUIRE(found.size() == 1);
+                    REQUIRE(found.front().id == i);
+                }
+            }
+        }
+    }
+}
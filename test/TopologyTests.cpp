@@ -285,3 +285,209 @@ SCENARIO("004: Chain Topology", "[topology][chain]")
         }
     }
 }
+
+SCENARIO("005: Batched Topology edits", "[topology][batch]")
+{
+    GIVEN("A topology with a chain of two Edges")
+    {
+        mycad::Topology topo;
+        auto v0 = topo.addFreeVertex();
+        auto v1 = topo.addFreeVertex();
+        auto v2 = topo.addFreeVertex();
+        auto e0 = topo.makeEdge(v0, v1).value();
+        auto e1 = topo.makeEdge(v1, v2).value();
+        mycad::Chain chain = topo.joinEdges(e0, e1).value();
+
+        mycad::Topology orig = topo;
+
+        WHEN("A batch is started")
+        {
+            REQUIRE(topo.beginBatch());
+
+            THEN("A second batch cannot be started")
+            {
+                REQUIRE(topo.inBatch());
+                REQUIRE_FALSE(topo.beginBatch());
+            }
+
+            THEN("Duplicate Edges are still rejected")
+            {
+                auto v3 = topo.addFreeVertex();
+                REQUIRE(topo.makeEdge(v2, v3).has_value());
+                REQUIRE_FALSE(topo.makeEdge(v3, v2).has_value());
+                REQUIRE_FALSE(topo.makeEdge(v1, v0).has_value());
+            }
+
+            AND_WHEN("Edits are made and then rolled back")
+            {
+                auto v3 = topo.addFreeVertex();
+                auto e2 = topo.makeEdge(v2, v3).value();
+                topo.joinEdges(e1, e2);
+                topo.deleteEdge(e0);
+                topo.makeEdge(v3, v3);
+
+                REQUIRE(topo.rollback());
+
+                THEN("The Topology is exactly what it was before the batch")
+                {
+                    REQUIRE_FALSE(topo.inBatch());
+                    REQUIRE(topo == orig);
+                    REQUIRE(topo.getChainEdges(chain) == mycad::EdgeIDs{e0, e1});
+                }
+            }
+
+            AND_WHEN("Edits are made and then committed")
+            {
+                auto v3 = topo.addFreeVertex();
+                auto e2 = topo.makeEdge(v2, v3).value();
+                mycad::Chain c2 = topo.joinEdges(e1, e2).value();
+                topo.deleteEdge(e0);
+
+                REQUIRE(topo.commit());
+
+                THEN("The edits are kept")
+                {
+                    REQUIRE_FALSE(topo.hasEdge(e0));
+                    REQUIRE(topo.getEdgeVertices(e2) == mycad::VertexIDPair{v2, v3});
+                    REQUIRE(topo.getChainEdges(c2) == mycad::EdgeIDs{e1, e2});
+                }
+
+                THEN("The Edge index reflects the edits")
+                {
+                    REQUIRE(topo.makeEdge(v0, v1).has_value());
+                    REQUIRE_FALSE(topo.makeEdge(v3, v2).has_value());
+                }
+            }
+        }
+
+        THEN("There is nothing to commit or roll back outside of a batch")
+        {
+            REQUIRE_FALSE(topo.commit());
+            REQUIRE_FALSE(topo.rollback());
+        }
+    }
+
+    GIVEN("A topology with many Edges")
+    {
+        mycad::Topology topo;
+        std::vector<mycad::VertexID> vs;
+        for (int i = 0; i < 10; i++)
+        {
+            vs.push_back(topo.addFreeVertex());
+        }
+        for (int i = 0; i < 9; i++)
+        {
+            topo.makeEdge(vs.at(i), vs.at(i + 1));
+        }
+
+        WHEN("A small batch is committed")
+        {
+            topo.beginBatch();
+            auto e = topo.makeEdge(vs.front(), vs.back()).value();
+            auto temp = topo.makeEdge(vs.at(0), vs.at(5)).value();
+            topo.deleteEdge(temp);
+            topo.commit();
+
+            THEN("The new Edges are merged in to the Edge index")
+            {
+                REQUIRE(topo.getEdgeVertices(e) == mycad::VertexIDPair{vs.front(), vs.back()});
+                REQUIRE_FALSE(topo.makeEdge(vs.back(), vs.front()).has_value());
+                REQUIRE(topo.makeEdge(vs.at(5), vs.at(0)).has_value());
+            }
+        }
+    }
+}
+
+SCENARIO("029: Deleting Vertices", "[topology][vertex]")
+{
+    GIVEN("A star of Edges around a middle Vertex, plus a loop")
+    {
+        mycad::Topology topo;
+        auto middle = topo.addFreeVertex();
+        auto a = topo.addFreeVertex();
+        auto b = topo.addFreeVertex();
+        auto c = topo.addFreeVertex();
+        auto ea = topo.makeEdge(middle, a).value();
+        auto eb = topo.makeEdge(middle, b).value();
+        auto loop = topo.makeEdge(middle, middle).value();
+        auto ebc = topo.makeEdge(b, c).value();
+
+        mycad::Topology orig = topo;
+
+        WHEN("The middle Vertex is deleted")
+        {
+            REQUIRE(topo.deleteVertex(middle));
+
+            THEN("It and its Edges are gone, and nothing else is")
+            {
+                REQUIRE_FALSE(topo.hasVertex(middle));
+                REQUIRE_FALSE(topo.hasEdge(ea));
+                REQUIRE_FALSE(topo.hasEdge(eb));
+                REQUIRE_FALSE(topo.hasEdge(loop));
+                REQUIRE(topo.hasEdge(ebc));
+
+                REQUIRE(topo.linksAt(a).empty());
+                REQUIRE(topo.linksAt(b).size() == 1);
+                REQUIRE(topo.vertexCount() == 4);
+            }
+
+            THEN("It can't be deleted or used again")
+            {
+                REQUIRE_FALSE(topo.deleteVertex(middle));
+                REQUIRE_FALSE(topo.makeEdge(middle, c).has_value());
+                REQUIRE(topo.linksAt(middle).empty());
+            }
+        }
+
+        WHEN("It is deleted and the Topology is compacted")
+        {
+            REQUIRE(topo.deleteVertex(middle));
+            auto const remap = topo.compact().value();
+
+            THEN("The IDs that are left close up, in the same order")
+            {
+                using V = mycad::MaybeVertexID;
+                using E = mycad::MaybeEdgeID;
+                REQUIRE(remap.vertices == std::vector<V>{std::nullopt, 0, 1, 2});
+                REQUIRE(remap.edges == std::vector<E>{std::nullopt, std::nullopt, std::nullopt, 0});
+
+                REQUIRE(topo.vertexCount() == 3);
+                REQUIRE(topo.edgeIDs() == mycad::EdgeIDs{0});
+                REQUIRE(topo.getEdgeVertices(0) == mycad::VertexIDPair{1, 2});
+                REQUIRE(topo.linksAt(1).size() == 1);
+                REQUIRE(topo.linksAt(0).empty());
+            }
+
+            THEN("New IDs carry on from the compacted ones")
+            {
+                REQUIRE(topo.addFreeVertex() == 3);
+                REQUIRE(topo.makeEdge(0, 1) == mycad::MaybeEdgeID{1});
+                REQUIRE_FALSE(topo.makeEdge(2, 1).has_value());
+            }
+        }
+
+        WHEN("It is compacted during a batch")
+        {
+            REQUIRE(topo.beginBatch());
+
+            THEN("Nothing happens")
+            {
+                REQUIRE_FALSE(topo.compact().has_value());
+                REQUIRE(topo.rollback());
+                REQUIRE(topo == orig);
+            }
+        }
+
+        WHEN("It is deleted during a batch that is rolled back")
+        {
+            REQUIRE(topo.beginBatch());
+            REQUIRE(topo.deleteVertex(middle));
+            REQUIRE(topo.rollback());
+
+            THEN("The topology is restored exactly")
+            {
+                REQUIRE(topo == orig);
+            }
+        }
+    }
+}
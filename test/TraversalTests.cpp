@@ -0,0 +1,133 @@
+#include "mycad/Entity.h"
+#include "mycad/Traversal.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+SCENARIO("007: Topology Traversal", "[topology][traversal]")
+{
+    GIVEN("A square of four Edges with a tail hanging off one corner")
+    {
+        //  v3 ─── v2
+        //  │       │
+        //  v0 ─── v1 ─── v4
+        mycad::Topology topo;
+        std::vector<mycad::VertexID> v;
+        for (int i = 0; i < 5; i++)
+        {
+            v.push_back(topo.addFreeVertex());
+        }
+        auto e01 = topo.makeEdge(v[0], v[1]).value();
+        auto e12 = topo.makeEdge(v[1], v[2]).value();
+        auto e23 = topo.makeEdge(v[2], v[3]).value();
+        auto e30 = topo.makeEdge(v[3], v[0]).value();
+        auto e14 = topo.makeEdge(v[1], v[4]).value();
+
+        mycad::TraversalScratch scratch;
+
+        THEN("A breadth-first traversal reaches every Vertex, nearest first")
+        {
+            auto order = mycad::breadthFirst(topo, v[0], scratch);
+
+            REQUIRE(order.size() == 5);
+            REQUIRE(order.front() == v[0]);
+            REQUIRE(scratch.depth(v[1]) == 1);
+            REQUIRE(scratch.depth(v[3]) == 1);
+            REQUIRE(scratch.depth(v[2]) == 2);
+            REQUIRE(scratch.depth(v[4]) == 2);
+            REQUIRE(std::ranges::is_sorted(order, {},
+                        [&scratch](auto vid){return *scratch.depth(vid);}));
+        }
+
+        THEN("The first ring around a Vertex holds its neighbours")
+        {
+            auto ring = mycad::ringNeighbourhood(topo, v[1], 1, scratch);
+            std::vector<mycad::VertexID> sorted(ring.begin(), ring.end());
+            std::ranges::sort(sorted);
+
+            REQUIRE(sorted == std::vector{v[0], v[1], v[2], v[4]});
+            REQUIRE_FALSE(scratch.isVisited(v[3]));
+        }
+
+        THEN("The shortest path takes the fewest Edges")
+        {
+            REQUIRE(mycad::shortestPath(topo, v[3], v[1], scratch)->size() == 2);
+            REQUIRE(mycad::shortestPath(topo, v[0], v[4], scratch) ==
+                    mycad::EdgeIDs{e01, e14});
+            REQUIRE(mycad::shortestPath(topo, v[2], v[2], scratch) ==
+                    mycad::EdgeIDs{});
+        }
+
+        THEN("The weighted shortest path avoids expensive Edges")
+        {
+            auto weight = [e01](mycad::EdgeID e){return e == e01 ? 10.0f : 1.0f;};
+            REQUIRE(mycad::weightedShortestPath(topo, v[0], v[1], scratch, weight) ==
+                    mycad::EdgeIDs{e30, e23, e12});
+        }
+
+        WHEN("The scratch is re-used for a smaller query")
+        {
+            mycad::breadthFirst(topo, v[0], scratch);
+            mycad::breadthFirst(topo, v[4], scratch, 0);
+
+            THEN("Nothing from the previous traversal is left over")
+            {
+                REQUIRE(scratch.order().size() == 1);
+                REQUIRE(scratch.isVisited(v[4]));
+                REQUIRE_FALSE(scratch.isVisited(v[0]));
+            }
+        }
+
+        WHEN("A Vertex is disconnected")
+        {
+            auto lonely = topo.addFreeVertex();
+
+            THEN("There is no path to it")
+            {
+                REQUIRE_FALSE(mycad::shortestPath(topo, v[0], lonely, scratch).has_value());
+            }
+        }
+
+        THEN("Traversals from invalid Vertices find nothing")
+        {
+            REQUIRE(mycad::breadthFirst(topo, 100, scratch).empty());
+            REQUIRE_FALSE(mycad::shortestPath(topo, v[0], 100, scratch).has_value());
+        }
+    }
+}
+
+SCENARIO("008: Entity Traversal", "[entity][traversal]")
+{
+    GIVEN("Two routes between a pair of Vertices")
+    {
+        // the direct route has fewer Edges but is longer
+        mycad::Entity entity;
+        auto v0 = entity.addVertex({0, 0, 0});
+        auto v1 = entity.addVertex({10, 0, 0});
+        auto v2 = entity.addVertex({5, 20, 0});
+        auto v3 = entity.addVertex({3, 0.5, 0});
+        auto v4 = entity.addVertex({7, 0.5, 0});
+
+        auto far1 = entity.addEdge(v0, v2).value();
+        auto far2 = entity.addEdge(v2, v1).value();
+        auto near1 = entity.addEdge(v0, v3).value();
+        auto near2 = entity.addEdge(v3, v4).value();
+        auto near3 = entity.addEdge(v4, v1).value();
+
+        mycad::TraversalScratch scratch;
+
+        THEN("The topological shortest path takes the fewest Edges")
+        {
+            REQUIRE(mycad::shortestPath(entity.getTopology(), v0, v1, scratch) ==
+                    mycad::EdgeIDs{far1, far2});
+        }
+
+        THEN("The geometric shortest path takes the shortest route")
+        {
+            REQUIRE(entity.shortestPath(v0, v1, scratch) ==
+                    mycad::EdgeIDs{near1, near2, near3});
+        }
+    }
+}